@@ -0,0 +1,201 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Capture threads are stopped and joined on all exit paths.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/multimedia/aggregate_input.hpp"
+#include "pfs/multimedia/audio.hpp"
+#include <pulse/simple.h>
+#include <pulse/error.h>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+
+using namespace multimedia;
+
+static int const SAMPLE_RATE = 48000;
+static int const CHANNELS = 2;
+static std::size_t const FRAGMENT_FRAMES = SAMPLE_RATE / 100;
+static int const MAX_LAG = 480;
+
+static std::int64_t now_usec ()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Lag (frames) of the channel `b` relative to channel `a` by maximum of
+// cross-correlation.
+static int measure_lag (std::vector<float> const & frames, int stride, int a, int b)
+{
+    auto count = static_cast<int>(frames.size()) / stride;
+    int result = 0;
+    double best = 0;
+
+    for (int lag = -MAX_LAG; lag <= MAX_LAG; lag++) {
+        double sum = 0;
+
+        for (int i = MAX_LAG; i < count - MAX_LAG; i++)
+            sum += frames[i * stride + a] * frames[(i + lag) * stride + b];
+
+        if (sum > best) {
+            best = sum;
+            result = lag;
+        }
+    }
+
+    return result;
+}
+
+// Usage: aggregate_capture SECONDS SOURCE...
+//
+// Captures sources (e.g. monitors of null sinks fed by one generator) into
+// aggregated frames and reports drift and alignment of the devices relative
+// to the first one. Test setup:
+//      pactl load-module module-null-sink sink_name=mic1
+//      pactl load-module module-null-sink sink_name=mic2
+//      pactl load-module module-combine-sink sink_name=mics slaves=mic1,mic2
+//      paplay -d mics some-noise.wav
+//      aggregate_capture 30 mic1.monitor mic2.monitor
+int main (int argc, char * argv[])
+{
+    if (argc < 4) {
+        std::cerr << "Usage: " << argv[0] << " SECONDS SOURCE SOURCE...\n\nAvailable sources:\n";
+
+        for (auto const & d: audio::fetch_devices(audio::device_mode::input))
+            std::cerr << "\t" << d.name << "\n";
+
+        return EXIT_FAILURE;
+    }
+
+    auto seconds = std::atoi(argv[1]);
+    std::vector<audio::aggregate_device> devices;
+
+    for (int i = 2; i < argc; i++)
+        devices.push_back(audio::aggregate_device{argv[i], CHANNELS});
+
+    audio::aggregate_options opts;
+    opts.sample_rate = SAMPLE_RATE;
+    audio::aggregate_input aggregate {devices, opts};
+
+    pa_sample_spec ss;
+    ss.format = PA_SAMPLE_FLOAT32NE;
+    ss.rate = SAMPLE_RATE;
+    ss.channels = CHANNELS;
+
+    pa_buffer_attr attr;
+    attr.maxlength = static_cast<std::uint32_t>(-1);
+    attr.tlength = static_cast<std::uint32_t>(-1);
+    attr.prebuf = static_cast<std::uint32_t>(-1);
+    attr.minreq = static_cast<std::uint32_t>(-1);
+    attr.fragsize = static_cast<std::uint32_t>(FRAGMENT_FRAMES * CHANNELS * sizeof(float));
+
+    // All streams are opened before capture threads are started, so there
+    // are no threads to stop on failure
+    std::vector<pa_simple *> streams;
+
+    for (std::size_t index = 0; index < devices.size(); index++) {
+        int error = 0;
+        auto s = pa_simple_new(nullptr, "aggregate_capture", PA_STREAM_RECORD
+            , devices[index].name.c_str(), "capture", & ss, nullptr, & attr, & error);
+
+        if (!s) {
+            std::cerr << "Open failure: " << devices[index].name << ": " << pa_strerror(error) << "\n";
+
+            for (auto opened: streams)
+                pa_simple_free(opened);
+
+            return EXIT_FAILURE;
+        }
+
+        streams.push_back(s);
+    }
+
+    std::atomic<bool> stop {false};
+    std::atomic<bool> read_failure {false};
+    std::vector<std::thread> capture_threads;
+
+    for (std::size_t index = 0; index < streams.size(); index++) {
+        auto s = streams[index];
+
+        capture_threads.emplace_back([& aggregate, & stop, & read_failure, s, index] {
+            std::vector<float> samples(FRAGMENT_FRAMES * CHANNELS);
+            int error = 0;
+
+            while (!stop && pa_simple_read(s, samples.data(), samples.size() * sizeof(float), & error) >= 0) {
+                // Capture time of the first frame: fragment and data
+                // queued in the server are older than now
+                auto latency = pa_simple_get_latency(s, & error);
+                auto time_usec = now_usec() - static_cast<std::int64_t>(latency)
+                    - static_cast<std::int64_t>(FRAGMENT_FRAMES * 1000000 / SAMPLE_RATE);
+
+                aggregate.write(index, samples.data(), FRAGMENT_FRAMES, time_usec);
+            }
+
+            if (!stop) {
+                std::cerr << "Read failure: " << pa_strerror(error) << "\n";
+                read_failure = true;
+            }
+
+            pa_simple_free(s);
+        });
+    }
+
+    auto stride = aggregate.channels();
+    std::vector<float> frames;
+    std::vector<float> buffer(FRAGMENT_FRAMES * stride);
+
+    std::cout << std::fixed << std::setprecision(1);
+
+    // Assembly stalls if any device stops delivering fragments
+    for (int second = 0; second < seconds && !read_failure; ) {
+        auto n = aggregate.read(buffer.data(), FRAGMENT_FRAMES);
+
+        if (n == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            continue;
+        }
+
+        frames.insert(frames.end(), buffer.begin(), buffer.begin() + n * stride);
+
+        if (frames.size() < static_cast<std::size_t>(SAMPLE_RATE * stride))
+            continue;
+
+        std::cout << "[" << ++second << "s]";
+
+        for (std::size_t i = 0; i < devices.size(); i++) {
+            auto st = aggregate.stats(i);
+            std::cout << " dev" << i << ": drift " << st.drift_ppm << " ppm";
+
+            if (i > 0) {
+                std::cout << ", lag " << measure_lag(frames, stride, 0, static_cast<int>(i) * CHANNELS)
+                    << ", realign " << st.realignments
+                    << ", underrun " << st.underrun_frames
+                    << ", overrun " << st.overrun_frames;
+            }
+
+            std::cout << ";";
+        }
+
+        std::cout << "\n";
+        frames.clear();
+    }
+
+    stop = true;
+
+    for (auto & t: capture_threads)
+        t.join();
+
+    return read_failure ? EXIT_FAILURE : EXIT_SUCCESS;
+}
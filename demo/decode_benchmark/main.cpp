@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Decode pipeline moved into `multimedia::video`.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/multimedia/decode_pipeline.hpp"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <initializer_list>
+#include <string>
+#include <thread>
+#include <cstdlib>
+
+using namespace multimedia;
+
+// Usage: decode_benchmark FILE
+//
+// Test file can be generated by `encode_benchmark FILE` or with FFmpeg, e.g.:
+//      ffmpeg -f lavfi -i testsrc2=size=1920x1080:rate=30 -f lavfi -i sine=frequency=440
+//          -t 20 -c:v libx264 -c:a aac test1080p.mp4
+int main (int argc, char * argv[])
+{
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " FILE\n";
+        return EXIT_FAILURE;
+    }
+
+    std::string path {argv[1]};
+    std::cout << std::fixed << std::setprecision(1);
+
+    for (int threads: {1, 2, 4, 0}) {
+        video::decode_pipeline pipeline;
+        video::decode_options opts;
+        opts.decoder_threads = threads;
+        error_code ec;
+
+        if (!pipeline.open(path, opts, ec)) {
+            std::cerr << "Open failure: " << path << ": " << ec.message() << "\n";
+            return EXIT_FAILURE;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        int audio_frames = 0;
+        int video_frames = 0;
+
+        // Output stages
+        std::thread audio_output {[& pipeline, & audio_frames] {
+            video::decoded_frame frame;
+
+            while (pipeline.read(video::media_type::audio, frame))
+                audio_frames++;
+        }};
+
+        video::decoded_frame frame;
+
+        while (pipeline.read(video::media_type::video, frame))
+            video_frames++;
+
+        audio_output.join();
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        auto vinfo = pipeline.info(video::media_type::video);
+
+        std::cout << "decoder threads: " << (threads == 0 ? std::string{"auto"} : std::to_string(threads))
+            << ", video (" << vinfo.codec_name << " " << vinfo.width << "x" << vinfo.height << "): "
+            << video_frames << " frames, " << video_frames / elapsed.count() << " fps"
+            << ", audio: " << audio_frames << " frames"
+            << ", elapsed: " << elapsed.count() << " s\n";
+    }
+
+    return EXIT_SUCCESS;
+}
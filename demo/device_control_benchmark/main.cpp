@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Sequential execution through one connection is the baseline.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/multimedia/audio.hpp"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <initializer_list>
+#include <string>
+#include <cstdlib>
+
+using namespace multimedia;
+
+static int const CHANGES_COUNT = 100;
+
+static void print_elapsed (char const * title
+    , std::chrono::steady_clock::time_point start)
+{
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << title << ": " << std::setw(9) << elapsed.count() << " ms ("
+        << elapsed.count() / CHANGES_COUNT << " ms per change)\n";
+}
+
+// Usage: device_control_benchmark VOLUME_PERCENT [SINK_NAME]
+//
+// Sets volume of the sink (default output device by default) 100 times:
+//   - connection per change (`audio::set_volume()` calls);
+//   - sequentially through one connection (each change is awaited before
+//     the next one is issued);
+//   - as a single pipelined batch.
+// Volume alternates around VOLUME_PERCENT and is left at VOLUME_PERCENT.
+int main (int argc, char * argv[])
+{
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " VOLUME_PERCENT [SINK_NAME]\n";
+        return EXIT_FAILURE;
+    }
+
+    float volume = std::atoi(argv[1]) / 100.f;
+    std::string sink = argc > 2 ? std::string{argv[2]} : audio::default_output_device().name;
+
+    if (sink.empty()) {
+        std::cerr << "No output device found\n";
+        return EXIT_FAILURE;
+    }
+
+    // Last change sets the requested volume
+    auto volume_at = [volume] (int i) {
+        return (CHANGES_COUNT - 1 - i) % 2 == 0 ? volume : volume * .99f;
+    };
+
+    std::cout << "sink: " << sink << "\n" << std::fixed << std::setprecision(2);
+
+    error_code ec;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < CHANGES_COUNT; i++) {
+        if (!audio::set_volume(audio::device_mode::output, sink, volume_at(i), ec)) {
+            std::cerr << "Set volume failure: " << ec.message() << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    print_elapsed("connection per change", start);
+
+    for (auto mode: {audio::control_batch::execution::sequential
+            , audio::control_batch::execution::pipelined}) {
+        start = std::chrono::steady_clock::now();
+        audio::control_batch batch;
+
+        for (int i = 0; i < CHANGES_COUNT; i++)
+            batch.set_volume(audio::device_mode::output, sink, volume_at(i));
+
+        if (!batch.execute(mode, ec)) {
+            std::cerr << "Set volume failure: " << ec.message() << "\n";
+            return EXIT_FAILURE;
+        }
+
+        print_elapsed(mode == audio::control_batch::execution::sequential
+            ? "sequential           " : "pipelined            ", start);
+    }
+
+    return EXIT_SUCCESS;
+}
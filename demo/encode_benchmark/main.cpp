@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/multimedia/video_encoder.hpp"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <initializer_list>
+#include <string>
+#include <cstdlib>
+
+using namespace multimedia;
+
+static constexpr int WIDTH = 1920;
+static constexpr int HEIGHT = 1080;
+static constexpr int FRAMES = 300;
+
+// Moving diagonal gradient
+static void generate (video::frame & f, int n)
+{
+    for (int y = 0; y < f.height(); y++) {
+        auto row = f.data(0) + y * f.stride(0);
+
+        for (int x = 0; x < f.width(); x++) {
+            row[4 * x + 0] = static_cast<std::uint8_t>(x + n);
+            row[4 * x + 1] = static_cast<std::uint8_t>(y + 2 * n);
+            row[4 * x + 2] = static_cast<std::uint8_t>(x + y);
+            row[4 * x + 3] = 255;
+        }
+    }
+}
+
+// Encodes generated frames. Returns frames per second or negative value
+// on failure.
+static double encode (video::encoder & enc, error_code & ec)
+{
+    video::frame_pool pool {video::pixel_format::rgba, WIDTH, HEIGHT};
+    auto start = std::chrono::steady_clock::now();
+
+    for (int n = 0; n < FRAMES; n++) {
+        auto f = pool.acquire();
+        generate(f, n);
+
+        if (!enc.submit(f))
+            break;
+    }
+
+    if (!enc.finish(ec))
+        return -1;
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return FRAMES / elapsed.count();
+}
+
+// Usage: encode_benchmark [OUTPUT_FILE]
+//
+// Encodes 1920x1080 RGBA frames at several x264 presets into memory.
+// If OUTPUT_FILE is specified, also writes the test file (e.g. for the
+// `decode_benchmark`).
+int main (int argc, char * argv[])
+{
+    video::encoder_options opts;
+    opts.width = WIDTH;
+    opts.height = HEIGHT;
+    opts.frame_rate = 30;
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << WIDTH << "x" << HEIGHT << " RGBA, " << FRAMES << " frames\n";
+
+    for (auto preset: {"ultrafast", "veryfast", "fast", "medium"}) {
+        video::encoder enc;
+        error_code ec;
+        std::size_t bytes = 0;
+
+        opts.preset = preset;
+
+        if (!enc.open([& bytes] (video::packet const & p) { bytes += p.size; }, opts, ec)) {
+            std::cerr << "Open encoder failure: " << ec.message() << "\n";
+            return EXIT_FAILURE;
+        }
+
+        auto fps = encode(enc, ec);
+
+        if (fps < 0) {
+            std::cerr << "Encoding failure: " << ec.message() << "\n";
+            return EXIT_FAILURE;
+        }
+
+        std::cout << std::setw(10) << preset << ": " << fps << " fps, "
+            << bytes / 1024 << " KiB\n";
+    }
+
+    if (argc > 1) {
+        video::encoder enc;
+        error_code ec;
+
+        opts.preset = "veryfast";
+
+        if (!enc.open(std::string{argv[1]}, opts, ec) || encode(enc, ec) < 0) {
+            std::cerr << "Write test file failure: " << argv[1] << ": " << ec.message() << "\n";
+            return EXIT_FAILURE;
+        }
+
+        std::cout << "Test file written: " << argv[1] << "\n";
+    }
+
+    return EXIT_SUCCESS;
+}
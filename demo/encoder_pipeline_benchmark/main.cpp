@@ -0,0 +1,319 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Real Opus/FLAC encoding, spin encoder is the queue overhead baseline.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/multimedia/audio_encoders.hpp"
+#include "pfs/multimedia/encoder_pipeline.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <iomanip>
+#include <initializer_list>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+
+using namespace multimedia;
+
+using clock_type = std::chrono::steady_clock;
+
+static std::size_t const FRAMES = 480;  // 10 ms at 48 kHz
+static int const CHANNELS = 2;
+static std::size_t const SIGNAL_FRAGMENTS = 100;
+
+using encoder_factory = std::function<std::unique_ptr<audio::encoder> ()>;
+
+// One second of stereo music-like signal (tones with vibrato and noise), so
+// that real encoders do not take their silence shortcuts. Fragments are
+// submitted from it cyclically.
+static std::vector<float> make_signal ()
+{
+    std::vector<float> signal(SIGNAL_FRAGMENTS * FRAMES * CHANNELS);
+    std::mt19937 rng {1};
+    std::normal_distribution<float> noise {0.f, 0.02f};
+    double const pi = 3.14159265358979323846;
+
+    for (std::size_t i = 0; i < SIGNAL_FRAGMENTS * FRAMES; i++) {
+        auto t = static_cast<double>(i) / 48000;
+        auto vibrato = 3 * std::sin(2 * pi * 5 * t);
+
+        for (int c = 0; c < CHANNELS; c++) {
+            auto x = 0.3 * std::sin(2 * pi * (220 + 110 * c + vibrato) * t)
+                + 0.2 * std::sin(2 * pi * 1375 * t + c);
+            signal[i * CHANNELS + static_cast<std::size_t>(c)] = static_cast<float>(x) + noise(rng);
+        }
+    }
+
+    return signal;
+}
+
+static std::vector<float> const & test_signal ()
+{
+    static std::vector<float> instance = make_signal();
+    return instance;
+}
+
+static float const * fragment_at (std::size_t index)
+{
+    return test_signal().data() + (index % SIGNAL_FRAGMENTS) * FRAMES * CHANNELS;
+}
+
+// Queue overhead baseline: encoder stand-in burning the given CPU time per
+// fragment, it does not encode anything. Shows the pipeline overhead
+// (queueing, scheduling, stealing) with the cost of encoding fixed.
+class busy_encoder: public audio::encoder
+{
+    std::chrono::microseconds _cost;
+
+public:
+    explicit busy_encoder (int cost_usec)
+        : _cost(cost_usec)
+    {}
+
+    void encode (float const * samples
+        , std::size_t frames
+        , std::uint64_t pts
+        , audio::packet_emitter const & emit) override
+    {
+        auto deadline = clock_type::now() + _cost;
+        volatile float acc = 0;
+
+        while (clock_type::now() < deadline) {
+            for (std::size_t i = 0; i < frames; i += 16)
+                acc = acc + samples[i];
+        }
+
+        std::uint8_t packet[4] {};
+        emit(packet, sizeof(packet), pts);
+    }
+};
+
+// Submits fragments to `streams` streams as fast as the queues accept them.
+static void throughput (std::size_t threads, std::size_t streams, encoder_factory const & factory)
+{
+    audio::encoder_pipeline_options opts;
+    opts.threads = threads;
+    opts.max_streams = streams;
+    opts.max_frames = FRAMES;
+
+    std::atomic<std::uint64_t> packets {0};
+    audio::encoder_pipeline pipeline {opts, [& packets] (audio::encoded_packet const &) {
+        packets.fetch_add(1, std::memory_order_relaxed);
+    }};
+
+    for (std::size_t i = 0; i < streams; i++)
+        pipeline.add_stream(factory(), CHANNELS);
+
+    std::vector<std::size_t> next(streams, 0);
+    std::uint64_t rejected = 0;
+
+    auto start = clock_type::now();
+    auto deadline = start + std::chrono::seconds(1);
+
+    while (clock_type::now() < deadline) {
+        for (std::size_t s = 0; s < streams; s++) {
+            if (pipeline.submit(static_cast<int>(s), fragment_at(next[s]), FRAMES))
+                next[s]++;
+            else
+                rejected++;
+        }
+    }
+
+    pipeline.stop();
+
+    std::chrono::duration<double> elapsed = clock_type::now() - start;
+    auto fragments_per_sec = static_cast<double>(packets) / elapsed.count();
+
+    // A real-time stream produces 100 fragments per second
+    std::cout << std::setw(8) << threads << std::setw(9) << streams
+        << std::setw(16) << fragments_per_sec
+        << std::setw(18) << fragments_per_sec / 100 / static_cast<double>(threads) << "\n";
+}
+
+// Real-time paced capture: every 10 ms each stream submits a fragment.
+// Latency is measured from submit to the packet emission.
+static void latency (std::size_t threads, std::size_t streams, encoder_factory const & factory
+    , int seconds)
+{
+    audio::encoder_pipeline_options opts;
+    opts.threads = threads;
+    opts.max_streams = streams;
+    opts.max_frames = FRAMES;
+
+    std::size_t const ticks = static_cast<std::size_t>(seconds) * 100;
+    std::vector<clock_type::time_point> submitted(streams * ticks);
+    std::vector<double> latencies(streams * ticks, 0);
+    std::atomic<std::size_t> emitted {0};
+
+    audio::encoder_pipeline pipeline {opts, [&] (audio::encoded_packet const & p) {
+        auto index = static_cast<std::size_t>(p.stream) * ticks + p.pts / FRAMES;
+        std::chrono::duration<double, std::micro> d = clock_type::now() - submitted[index];
+        latencies[index] = d.count();
+        emitted++;
+    }};
+
+    for (std::size_t i = 0; i < streams; i++)
+        pipeline.add_stream(factory(), CHANNELS);
+
+    std::uint64_t rejected = 0;
+    auto next = clock_type::now();
+
+    for (std::size_t t = 0; t < ticks; t++) {
+        std::this_thread::sleep_until(next);
+        next += std::chrono::milliseconds(10);
+
+        for (std::size_t s = 0; s < streams; s++) {
+            // Timestamp is written before the fragment becomes visible to
+            // workers
+            submitted[s * ticks + t] = clock_type::now();
+
+            if (!pipeline.submit(static_cast<int>(s), fragment_at(t), FRAMES))
+                rejected++;
+        }
+    }
+
+    pipeline.stop();
+
+    // Rejected fragments shift pts of the following ones (index of the
+    // submit time), so latency is reported only when nothing was rejected
+    std::sort(latencies.begin(), latencies.end());
+
+    auto at = [& latencies] (double q) {
+        return latencies[static_cast<std::size_t>(q * static_cast<double>(latencies.size() - 1))];
+    };
+
+    std::cout << std::setw(8) << threads << std::setw(9) << streams;
+
+    if (rejected > 0) {
+        std::cout << "   overloaded (" << rejected << " fragments rejected)\n";
+        return;
+    }
+
+    std::cout << std::setw(12) << at(0.5) << std::setw(12) << at(0.99)
+        << std::setw(12) << latencies.back() << "\n";
+}
+
+// Average CPU time of encoding one fragment on the calling thread (us).
+static double fragment_cost (encoder_factory const & factory)
+{
+    auto enc = factory();
+    std::size_t const count = 3 * SIGNAL_FRAGMENTS;
+    audio::packet_emitter emit = [] (std::uint8_t const *, std::size_t, std::uint64_t) {};
+
+    auto start = clock_type::now();
+
+    for (std::size_t i = 0; i < count; i++)
+        enc->encode(fragment_at(i), FRAMES, i * FRAMES, emit);
+
+    std::chrono::duration<double, std::micro> elapsed = clock_type::now() - start;
+    return elapsed.count() / static_cast<double>(count);
+}
+
+static void run (std::string const & title, encoder_factory const & factory, std::size_t max_threads)
+{
+    auto cost = fragment_cost(factory);
+
+    std::cout << std::fixed << std::setprecision(0);
+    std::cout << "\n" << title << ": " << std::setprecision(1) << cost << " us per fragment\n"
+        << std::setprecision(0);
+
+    std::cout << "Throughput\n";
+    std::cout << " threads  streams     fragments/s  streams per core\n";
+
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        for (std::size_t streams: {1, 16, 256})
+            throughput(threads, streams, factory);
+    }
+
+    std::cout << "Latency (real-time streams, submit to packet, us)\n";
+    std::cout << " threads  streams         p50         p99         max\n";
+
+    // Up to the estimated capacity of the workers
+    auto capacity = static_cast<std::size_t>(10000 / std::max(cost, 1.0)) * max_threads;
+
+    for (std::size_t streams = 1; streams <= capacity; streams *= 4)
+        latency(max_threads, streams, factory, 3);
+}
+
+// Usage: encoder_pipeline_benchmark [THREADS [SPIN_USEC]]
+//
+// THREADS is the number of workers (default is hardware concurrency).
+// Opus and FLAC encoding is benchmarked when the library is built with them
+// (MULTIMEDIA__ENABLE_OPUS, MULTIMEDIA__ENABLE_FLAC). SPIN_USEC is the CPU
+// time per fragment of the queue overhead baseline (default is 100 us,
+// close to Opus at 48 kHz stereo on a desktop core).
+int main (int argc, char * argv[])
+{
+    std::size_t hw = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t max_threads = argc > 1 ? static_cast<std::size_t>(std::atoi(argv[1])) : hw;
+    int cost_usec = argc > 2 ? std::atoi(argv[2]) : 100;
+
+    max_threads = std::max<std::size_t>(1, max_threads);
+
+    std::cout << "fragment: " << FRAMES << " frames x " << CHANNELS << " channels (10 ms at 48 kHz)\n";
+
+    run("Queue overhead baseline (spin encoder, " + std::to_string(cost_usec) + " us, no encoding)"
+        , [cost_usec] { return std::unique_ptr<audio::encoder>{new busy_encoder{cost_usec}}; }
+        , max_threads);
+
+#if MULTIMEDIA__OPUS_ENABLED
+    {
+        audio::opus_encoder_options opts;
+        opts.channels = CHANNELS;
+        opts.frame_size = FRAMES;
+        opts.bitrate = 128000;
+
+        run("Opus (128 kbit/s, complexity 10, 10 ms packets)", [opts] {
+            multimedia::error_code ec;
+            auto enc = audio::make_opus_encoder(opts, ec);
+
+            if (!enc) {
+                std::cerr << "Opus encoder creation failure: " << ec.message() << "\n";
+                std::exit(EXIT_FAILURE);
+            }
+
+            return enc;
+        }, max_threads);
+    }
+#else
+    std::cout << "\nOpus: not enabled (MULTIMEDIA__ENABLE_OPUS)\n";
+#endif
+
+#if MULTIMEDIA__FLAC_ENABLED
+    {
+        audio::flac_encoder_options opts;
+        opts.channels = CHANNELS;
+
+        // One FLAC frame per fragment (the encoder still holds a frame back
+        // until the next fragment arrives, it is included in the latency)
+        opts.block_size = FRAMES;
+
+        run("FLAC (16 bit, compression level 5, 480 frame blocks)", [opts] {
+            multimedia::error_code ec;
+            auto enc = audio::make_flac_encoder(opts, ec);
+
+            if (!enc) {
+                std::cerr << "FLAC encoder creation failure: " << ec.message() << "\n";
+                std::exit(EXIT_FAILURE);
+            }
+
+            return enc;
+        }, max_threads);
+    }
+#else
+    std::cout << "\nFLAC: not enabled (MULTIMEDIA__ENABLE_FLAC)\n";
+#endif
+
+    return EXIT_SUCCESS;
+}
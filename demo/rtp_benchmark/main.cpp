@@ -0,0 +1,195 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 L16 packet duration is at 44.1 kHz clock.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/multimedia/rtp.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <initializer_list>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+#ifndef _WIN32
+#   include <arpa/inet.h>
+#   include <netinet/in.h>
+#   include <sys/socket.h>
+#endif
+
+using namespace multimedia;
+
+static std::size_t const FRAMES = 960;     // 20 ms at 48 kHz
+static std::size_t const L16_FRAMES = 480; // About 10 ms at 44.1 kHz, fits the packet (MTU)
+
+using clock_type = std::chrono::steady_clock;
+
+static double seconds_since (clock_type::time_point start)
+{
+    return std::chrono::duration<double>(clock_type::now() - start).count();
+}
+
+static void report (char const * name, std::size_t packets, double seconds)
+{
+    std::cout << std::setw(36) << std::left << name << std::right
+        << std::setw(12) << static_cast<double>(packets) / seconds << " packets/s\n";
+}
+
+// Mono L16 packets of about 10 ms: conversion to network byte order and header
+// serialization.
+static void packetize (std::size_t count)
+{
+    std::vector<std::int16_t> samples(L16_FRAMES);
+    rtp::packetizer p {rtp::PAYLOAD_L16_MONO, 1};
+    rtp::packet_buffer packet;
+    std::size_t checksum = 0;
+
+    for (std::size_t i = 0; i < L16_FRAMES; i++)
+        samples[i] = static_cast<std::int16_t>(i * 37);
+
+    auto start = clock_type::now();
+
+    for (std::size_t i = 0; i < count; i++) {
+        samples[i % L16_FRAMES]++;
+
+        if (!p.pack_l16(samples.data(), L16_FRAMES, 1, packet)) {
+            std::cerr << "packetize failure\n";
+            return;
+        }
+
+        checksum += packet.data[rtp::HEADER_SIZE + 2 * (i % L16_FRAMES)];
+    }
+
+    report("packetize (L16, 480 frames mono)", count, seconds_since(start));
+    std::cout << "    checksum " << checksum << "\n";
+}
+
+// Parse and jitter buffer push/pop of the stream with 5% loss and 5%
+// packets reordered by one packet. One packet is played per 20 ms.
+static void jitter_buffer (std::size_t count)
+{
+    std::uint8_t payload[160] {};
+    rtp::packetizer p {rtp::PAYLOAD_OPUS, 1};
+    std::vector<rtp::packet_buffer> packets(count);
+    std::vector<bool> arrived(count);
+    std::mt19937 rng {1};
+    std::uniform_real_distribution<double> chance {0, 1};
+
+    for (std::size_t i = 0; i < count; i++) {
+        p.pack(payload, sizeof(payload), FRAMES, packets[i]);
+        arrived[i] = chance(rng) >= 0.05;
+
+        if (i > 0 && chance(rng) < 0.05)
+            std::swap(packets[i], packets[i - 1]);
+    }
+
+    rtp::jitter_buffer_options opts;
+    opts.packet_duration = FRAMES;
+
+    rtp::jitter_buffer jb {opts};
+    rtp::packet_buffer out;
+    std::int64_t time_usec = 0;
+
+    auto start = clock_type::now();
+
+    for (std::size_t i = 0; i < count; i++) {
+        if (arrived[i])
+            jb.push(packets[i], time_usec);
+
+        jb.pop(out);
+        time_usec += 20000;
+    }
+
+    report("parse + jitter buffer (5% loss)", count, seconds_since(start));
+
+    auto const & stats = jb.stats();
+    std::cout << "    played " << stats.played << ", lost " << stats.lost
+        << ", late " << stats.late << ", dropped " << stats.dropped << "\n";
+}
+
+#ifndef _WIN32
+// Loopback UDP send/receive of `batch` packets per system call.
+static void udp_loopback (std::size_t count, std::size_t batch)
+{
+    error_code ec;
+    rtp::udp_socket rx;
+    rtp::udp_socket tx;
+
+    if (!rx.bind("127.0.0.1", 0, ec)) {
+        std::cerr << "bind failure: " << ec.message() << "\n";
+        return;
+    }
+
+    // Port assigned by the system
+    sockaddr_in addr {};
+    socklen_t len = sizeof(addr);
+    ::getsockname(rx.native_handle(), reinterpret_cast<sockaddr *>(& addr), & len);
+
+    if (!tx.connect("127.0.0.1", ntohs(addr.sin_port), ec)) {
+        std::cerr << "connect failure: " << ec.message() << "\n";
+        return;
+    }
+
+    std::uint8_t payload[160] {};
+    rtp::packetizer p {rtp::PAYLOAD_OPUS, 1};
+    std::vector<rtp::packet_buffer> packets(batch);
+    std::vector<rtp::packet_buffer> received(batch);
+    std::size_t total = 0;
+
+    auto start = clock_type::now();
+
+    while (total < count) {
+        for (auto & packet: packets)
+            p.pack(payload, sizeof(payload), FRAMES, packet);
+
+        auto sent = tx.send(packets.data(), batch, ec);
+
+        if (sent < 0) {
+            std::cerr << "send failure: " << ec.message() << "\n";
+            return;
+        }
+
+        // Receive the whole batch to not overflow the socket buffer
+        for (int n = 0; n < sent; ) {
+            auto r = rx.receive(received.data(), batch, 1000, ec);
+
+            if (r <= 0) {
+                std::cerr << "receive failure: " << (r < 0 ? ec.message() : "timeout") << "\n";
+                return;
+            }
+
+            n += r;
+        }
+
+        total += static_cast<std::size_t>(sent);
+    }
+
+    std::string name = "UDP loopback, batch " + std::to_string(batch);
+    report(name.c_str(), total, seconds_since(start));
+}
+#endif
+
+// Usage: rtp_benchmark [PACKETS]
+int main (int argc, char * argv[])
+{
+    std::size_t count = argc > 1 ? static_cast<std::size_t>(std::atol(argv[1])) : 1000000;
+
+    std::cout << std::fixed << std::setprecision(0);
+
+    packetize(count);
+    jitter_buffer(count);
+
+#ifndef _WIN32
+    for (std::size_t batch: {1, 8, 32})
+        udp_loopback(count / 10, batch);
+#endif
+
+    return EXIT_SUCCESS;
+}
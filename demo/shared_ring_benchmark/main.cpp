@@ -0,0 +1,448 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 CPU cost, real-time fan-out compared with PulseAudio streams.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/multimedia/shared_ring.hpp"
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#if SHARED_RING_BENCHMARK__PULSE_SIMPLE_ENABLED
+#   include <pulse/simple.h>
+#   include <pulse/error.h>
+#endif
+
+using namespace multimedia;
+
+using clock_type = std::chrono::steady_clock;
+
+static std::size_t const FRAMES = 480;  // 10 ms at 48 kHz
+static int const CHANNELS = 2;
+static std::size_t const FRAME_BYTES = CHANNELS * sizeof(float);
+
+// User and system CPU time (seconds) of the process (`RUSAGE_SELF`) or of
+// its terminated and waited for children (`RUSAGE_CHILDREN`).
+static double cpu_seconds (int who)
+{
+    rusage usage;
+    getrusage(who, & usage);
+
+    return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec)
+        + static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+}
+
+// `streams` writers publish as fast as they can, each of them has `readers`
+// readers draining its ring. Readers are threads of this process, but they
+// attach through the shared memory file exactly like other processes do.
+static bool throughput (std::size_t streams, std::size_t readers, std::size_t capacity_frames)
+{
+    std::vector<std::unique_ptr<audio::shared_ring_writer>> writers;
+
+    for (std::size_t i = 0; i < streams; i++) {
+        error_code ec;
+        std::unique_ptr<audio::shared_ring_writer> w {new audio::shared_ring_writer};
+
+        if (!w->create("benchmark", CHANNELS, 48000, FRAME_BYTES, capacity_frames, ec)) {
+            std::cerr << "ERROR: create shared ring: " << ec.message() << "\n";
+            return false;
+        }
+
+        writers.push_back(std::move(w));
+    }
+
+    std::vector<std::unique_ptr<audio::shared_ring_reader>> subscribers;
+
+    for (std::size_t i = 0; i < streams * readers; i++) {
+        error_code ec;
+        std::unique_ptr<audio::shared_ring_reader> r {new audio::shared_ring_reader};
+
+        if (!r->open(writers[i / readers]->native_handle(), ec)) {
+            std::cerr << "ERROR: attach reader: " << ec.message() << "\n";
+            return false;
+        }
+
+        subscribers.push_back(std::move(r));
+    }
+
+    std::atomic<bool> finish {false};
+    std::atomic<std::uint64_t> frames_read {0};
+    std::vector<std::thread> threads;
+
+    auto cpu_before = cpu_seconds(RUSAGE_SELF);
+
+    for (auto & r: subscribers) {
+        auto reader = r.get();
+
+        threads.emplace_back([reader, & finish, & frames_read] {
+            std::vector<float> frames(FRAMES * CHANNELS);
+            std::uint64_t total = 0;
+
+            while (!finish.load(std::memory_order_relaxed)) {
+                auto n = reader->read(frames.data(), FRAMES);
+
+                if (n == 0)
+                    std::this_thread::yield();
+
+                total += n;
+            }
+
+            frames_read += total;
+        });
+    }
+
+    auto start = clock_type::now();
+    auto deadline = start + std::chrono::seconds(1);
+
+    for (auto & w: writers) {
+        auto writer = w.get();
+
+        threads.emplace_back([writer, deadline] {
+            std::vector<float> frames(FRAMES * CHANNELS, 0.f);
+
+            while (clock_type::now() < deadline) {
+                // Let readers run on machines with few cores
+                for (int i = 0; i < 16; i++)
+                    writer->write(frames.data(), FRAMES);
+
+                std::this_thread::yield();
+            }
+        });
+    }
+
+    std::this_thread::sleep_until(deadline);
+    finish = true;
+
+    for (auto & t: threads)
+        t.join();
+
+    std::chrono::duration<double> elapsed = clock_type::now() - start;
+    auto cpu = cpu_seconds(RUSAGE_SELF) - cpu_before;
+
+    std::uint64_t frames_written = 0;
+    std::uint64_t lost_frames = 0;
+    std::uint64_t overruns = 0;
+
+    for (auto & w: writers)
+        frames_written += w->position();
+
+    for (auto & r: subscribers) {
+        lost_frames += r->lost_frames();
+        overruns += r->overruns();
+    }
+
+    auto expected = static_cast<double>(frames_written) * static_cast<double>(readers);
+    auto lost_percent = expected > 0 ? 100. * static_cast<double>(lost_frames) / expected : 0.;
+
+    std::cout << std::setw(8) << streams << std::setw(9) << readers
+        << std::setw(14) << static_cast<double>(frames_written) / elapsed.count() / 1e6
+        << std::setw(14) << static_cast<double>(frames_read) / elapsed.count() / 1e6
+        << std::setw(10) << lost_percent
+        << std::setw(11) << overruns
+        << std::setw(11) << cpu / elapsed.count() << "\n";
+
+    return true;
+}
+
+struct fanout_cost
+{
+    double publisher;   // CPU seconds of the publisher (writer or server)
+    double subscribers; // CPU seconds of all subscribers
+};
+
+// Real-time fan-out of one capture stream: the writer publishes a fragment
+// every 10 ms, `readers` subscriber processes wake up every 10 ms and read
+// everything available (as capture clients do).
+static bool ring_fanout (std::size_t readers, int seconds, fanout_cost & cost)
+{
+    error_code ec;
+    audio::shared_ring_writer writer;
+
+    if (!writer.create("benchmark", CHANNELS, 48000, FRAME_BYTES, 48000, ec)) {
+        std::cerr << "ERROR: create shared ring: " << ec.message() << "\n";
+        return false;
+    }
+
+    auto children_before = cpu_seconds(RUSAGE_CHILDREN);
+    auto deadline = clock_type::now() + std::chrono::seconds(seconds);
+    std::vector<pid_t> pids;
+
+    for (std::size_t i = 0; i < readers; i++) {
+        auto pid = fork();
+
+        if (pid < 0) {
+            std::perror("ERROR: fork");
+            break;
+        }
+
+        if (pid == 0) {
+            // Subscriber process attaches by the inherited descriptor
+            audio::shared_ring_reader reader;
+
+            if (!reader.open(writer.native_handle(), ec))
+                _exit(EXIT_FAILURE);
+
+            std::vector<float> frames(FRAMES * CHANNELS);
+            auto next = clock_type::now();
+
+            while (next < deadline) {
+                next += std::chrono::milliseconds(10);
+                std::this_thread::sleep_until(next);
+
+                while (reader.read(frames.data(), FRAMES) > 0)
+                    ;
+            }
+
+            reader.close();
+            _exit(EXIT_SUCCESS);
+        }
+
+        pids.push_back(pid);
+    }
+
+    // Cost of forking is not accounted for the writer
+    auto self_before = cpu_seconds(RUSAGE_SELF);
+
+    std::vector<float> frames(FRAMES * CHANNELS, 0.f);
+    auto next = clock_type::now();
+
+    while (pids.size() == readers && next < deadline) {
+        writer.write(frames.data(), FRAMES);
+        next += std::chrono::milliseconds(10);
+        std::this_thread::sleep_until(next);
+    }
+
+    bool success = pids.size() == readers;
+
+    for (auto pid: pids) {
+        int status = 0;
+
+        if (waitpid(pid, & status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS)
+            success = false;
+    }
+
+    if (!success) {
+        std::cerr << "ERROR: subscriber process failure\n";
+        return false;
+    }
+
+    cost.publisher = cpu_seconds(RUSAGE_SELF) - self_before;
+    cost.subscribers = cpu_seconds(RUSAGE_CHILDREN) - children_before;
+    return true;
+}
+
+#if SHARED_RING_BENCHMARK__PULSE_SIMPLE_ENABLED
+
+// CPU time (seconds) of the sound server processes (PulseAudio or PipeWire
+// with its PulseAudio server), 0 if not found.
+static double server_cpu_seconds ()
+{
+    double result = 0;
+    auto dir = opendir("/proc");
+
+    if (dir == nullptr)
+        return 0;
+
+    while (auto entry = readdir(dir)) {
+        std::string pid = entry->d_name;
+
+        if (pid.empty() || pid.find_first_not_of("0123456789") != std::string::npos)
+            continue;
+
+        std::ifstream file {"/proc/" + pid + "/stat"};
+        std::string stat {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+
+        // Format: pid (comm) state ppid ... utime stime ... (`man 5 proc`)
+        auto open = stat.find('(');
+        auto close = stat.rfind(')');
+
+        if (open == std::string::npos || close == std::string::npos || close < open)
+            continue;
+
+        auto comm = stat.substr(open + 1, close - open - 1);
+
+        if (comm != "pulseaudio" && comm != "pipewire" && comm != "pipewire-pulse")
+            continue;
+
+        std::istringstream fields {stat.substr(close + 1)};
+        std::string field;
+        unsigned long utime = 0;
+        unsigned long stime = 0;
+
+        // Skip fields from `state` (3) to `cmajflt` (13)
+        for (int i = 3; i <= 13; i++)
+            fields >> field;
+
+        if (fields >> utime >> stime)
+            result += static_cast<double>(utime + stime) / static_cast<double>(sysconf(_SC_CLK_TCK));
+    }
+
+    closedir(dir);
+    return result;
+}
+
+// The same fan-out by the sound server: `streams` independent record
+// streams of the default source read 10 ms fragments. Returns false if the
+// server is not available.
+static bool pulse_fanout (std::size_t streams, int seconds, fanout_cost & cost, std::string & error_text)
+{
+    pa_sample_spec spec;
+    spec.format = PA_SAMPLE_FLOAT32NE;
+    spec.rate = 48000;
+    spec.channels = CHANNELS;
+
+    pa_buffer_attr attr;
+    attr.maxlength = static_cast<std::uint32_t>(-1);
+    attr.tlength = static_cast<std::uint32_t>(-1);
+    attr.prebuf = static_cast<std::uint32_t>(-1);
+    attr.minreq = static_cast<std::uint32_t>(-1);
+    attr.fragsize = static_cast<std::uint32_t>(FRAMES * FRAME_BYTES);
+
+    std::vector<pa_simple *> connections;
+    bool success = true;
+
+    for (std::size_t i = 0; i < streams; i++) {
+        int error = 0;
+        auto conn = pa_simple_new(nullptr, "shared_ring_benchmark", PA_STREAM_RECORD, nullptr
+            , "fan-out", & spec, nullptr, & attr, & error);
+
+        if (conn == nullptr) {
+            error_text = pa_strerror(error);
+            success = false;
+            break;
+        }
+
+        connections.push_back(conn);
+    }
+
+    if (success) {
+        std::atomic<bool> read_failure {false};
+        std::vector<std::thread> threads;
+
+        auto self_before = cpu_seconds(RUSAGE_SELF);
+        auto server_before = server_cpu_seconds();
+        auto deadline = clock_type::now() + std::chrono::seconds(seconds);
+
+        for (auto conn: connections) {
+            threads.emplace_back([conn, deadline, & read_failure] {
+                std::vector<float> frames(FRAMES * CHANNELS);
+                int error = 0;
+
+                while (clock_type::now() < deadline) {
+                    if (pa_simple_read(conn, frames.data(), FRAMES * FRAME_BYTES, & error) < 0) {
+                        read_failure = true;
+                        break;
+                    }
+                }
+            });
+        }
+
+        for (auto & t: threads)
+            t.join();
+
+        cost.subscribers = cpu_seconds(RUSAGE_SELF) - self_before;
+        cost.publisher = server_cpu_seconds() - server_before;
+        success = !read_failure;
+
+        if (read_failure)
+            error_text = "read failure";
+    }
+
+    for (auto conn: connections)
+        pa_simple_free(conn);
+
+    return success;
+}
+
+#endif // SHARED_RING_BENCHMARK__PULSE_SIMPLE_ENABLED
+
+// Usage: shared_ring_benchmark [CAPACITY_FRAMES]
+//
+// CAPACITY_FRAMES is the ring capacity (default is 48000, one second
+// at 48 kHz). CPU is the number of cores kept busy (CPU seconds per second).
+// Real-time fan-out is compared with independent PulseAudio record streams
+// when the benchmark is built with PulseAudio simple API and the server is
+// running.
+int main (int argc, char * argv[])
+{
+    std::size_t capacity_frames = argc > 1 ? static_cast<std::size_t>(std::atoi(argv[1])) : 48000;
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "block: " << FRAMES << " frames x " << CHANNELS << " channels, ring capacity "
+        << capacity_frames << " frames, hardware threads "
+        << std::thread::hardware_concurrency() << "\n\n";
+
+    std::cout << " streams  readers  written Mf/s     read Mf/s    lost %   overruns        CPU\n";
+
+    std::size_t const readers_max = audio::SHARED_RING_READERS_MAX;
+
+    for (std::size_t streams: {1, 4, 16}) {
+        for (std::size_t readers: {std::size_t{1}, std::size_t{4}, std::size_t{16}, readers_max}) {
+            if (!throughput(streams, readers, capacity_frames))
+                return EXIT_FAILURE;
+        }
+    }
+
+    int const seconds = 3;
+    bool pulse_available = false;
+    std::string pulse_error = "simple API not found, comparison is disabled";
+
+#if SHARED_RING_BENCHMARK__PULSE_SIMPLE_ENABLED
+    pulse_available = true;
+#endif
+
+    std::cout << "\nReal-time fan-out of one capture stream (CPU ms per second of audio)\n";
+    std::cout << " readers   ring writer  ring readers  pulse server  pulse client\n";
+
+    for (std::size_t readers: {std::size_t{1}, std::size_t{4}, std::size_t{16}, readers_max}) {
+        fanout_cost ring;
+
+        if (!ring_fanout(readers, seconds, ring))
+            return EXIT_FAILURE;
+
+        std::cout << std::setw(8) << readers
+            << std::setw(14) << ring.publisher * 1000 / seconds
+            << std::setw(14) << ring.subscribers * 1000 / seconds;
+
+#if SHARED_RING_BENCHMARK__PULSE_SIMPLE_ENABLED
+        fanout_cost pulse;
+
+        if (pulse_available)
+            pulse_available = pulse_fanout(readers, seconds, pulse, pulse_error);
+
+        if (pulse_available) {
+            std::cout << std::setw(14) << pulse.publisher * 1000 / seconds
+                << std::setw(14) << pulse.subscribers * 1000 / seconds;
+        }
+#endif
+
+        if (!pulse_available)
+            std::cout << std::setw(14) << "n/a" << std::setw(14) << "n/a";
+
+        std::cout << "\n";
+    }
+
+    if (!pulse_available)
+        std::cout << "PulseAudio: " << pulse_error << "\n";
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Added optional FFTW comparison.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/multimedia/spectrum_analyzer.hpp"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+
+#if SPECTRUM_BENCHMARK__FFTW_ENABLED
+#   include <fftw3.h>
+#endif
+
+using namespace multimedia;
+
+// Returns nanoseconds per call of `f`.
+template <typename F>
+static double measure_ns (double seconds, F && f)
+{
+    std::size_t calls = 0;
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed {0};
+
+    // Check the clock every 64 calls
+    while (elapsed.count() < seconds) {
+        for (int i = 0; i < 64; i++)
+            f();
+
+        calls += 64;
+        elapsed = std::chrono::steady_clock::now() - start;
+    }
+
+    return elapsed.count() * 1e9 / static_cast<double>(calls);
+}
+
+#if SPECTRUM_BENCHMARK__FFTW_ENABLED
+// Same work as `spectrum_analyzer::analyze()`: Hann window, real FFT
+// (FFTW_MEASURE plan) and magnitudes.
+static double fftw_ns (std::vector<float> const & frame, std::size_t n, double seconds)
+{
+    auto in = static_cast<float *>(fftwf_malloc(sizeof(float) * n));
+    auto out = static_cast<fftwf_complex *>(fftwf_malloc(sizeof(fftwf_complex) * (n / 2 + 1)));
+    auto plan = fftwf_plan_dft_r2c_1d(static_cast<int>(n), in, out, FFTW_MEASURE);
+
+    std::vector<float> window(n);
+    std::vector<float> magnitudes(n / 2 + 1);
+
+    for (std::size_t i = 0; i < n; i++)
+        window[i] = static_cast<float>(0.5 - 0.5 * std::cos(2 * 3.14159265358979323846 * i / n));
+
+    auto ns = measure_ns(seconds, [&] {
+        for (std::size_t i = 0; i < n; i++)
+            in[i] = frame[i] * window[i];
+
+        fftwf_execute(plan);
+
+        for (std::size_t k = 0; k < magnitudes.size(); k++)
+            magnitudes[k] = std::sqrt(out[k][0] * out[k][0] + out[k][1] * out[k][1]);
+    });
+
+    fftwf_destroy_plan(plan);
+    fftwf_free(out);
+    fftwf_free(in);
+
+    return ns;
+}
+#endif
+
+// Usage: spectrum_benchmark [SECONDS_PER_SIZE]
+//
+// FFTW (single precision) column is reported if the benchmark is built with
+// `MULTIMEDIA__BENCHMARK_FFTW` option.
+int main (int argc, char * argv[])
+{
+    double seconds = argc > 1 ? std::atof(argv[1]) : 0.5;
+
+    std::mt19937 rng {1};
+    std::uniform_real_distribution<float> dist {-1.f, 1.f};
+    std::vector<float> frame(16384);
+
+    for (auto & x: frame)
+        x = dist(rng);
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "   size      frames/s   ns/frame   ns/bin";
+
+#if SPECTRUM_BENCHMARK__FFTW_ENABLED
+    std::cout << "   FFTW ns/frame";
+#endif
+
+    std::cout << "\n";
+
+    for (std::size_t n = 256; n <= 16384; n *= 2) {
+        audio::spectrum_options opts;
+        opts.fft_size = n;
+
+        audio::spectrum_analyzer sa {opts};
+
+        auto ns = measure_ns(seconds, [& sa, & frame] {
+            sa.analyze(frame.data());
+        });
+
+        std::cout << std::setw(7) << n
+            << std::setw(14) << 1e9 / ns
+            << std::setw(11) << ns
+            << std::setw(9) << ns / static_cast<double>(sa.bins_count());
+
+#if SPECTRUM_BENCHMARK__FFTW_ENABLED
+        std::cout << std::setw(16) << fftw_ns(frame, n, seconds);
+#endif
+
+        std::cout << "\n";
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,259 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/multimedia/rtp.hpp"
+#include "pfs/multimedia/spectrum_analyzer.hpp"
+#include "pfs/multimedia/vad.hpp"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+using namespace multimedia;
+
+static std::size_t const BLOCK_FRAMES = 480;
+
+struct corpus_item
+{
+    std::string name;
+    int sample_rate;
+    std::vector<std::vector<float>> channels; // Deinterleaved samples
+};
+
+static std::uint32_t read_le (std::uint8_t const * p, int bytes)
+{
+    std::uint32_t result = 0;
+
+    for (int i = bytes - 1; i >= 0; i--)
+        result = (result << 8) | p[i];
+
+    return result;
+}
+
+// Loads 16-bit PCM WAV file.
+static bool load_wav (std::string const & path, corpus_item & item)
+{
+    std::ifstream ifs {path, std::ios::binary};
+    std::vector<std::uint8_t> data {std::istreambuf_iterator<char>{ifs}, std::istreambuf_iterator<char>{}};
+
+    if (data.size() < 12 || std::memcmp(data.data(), "RIFF", 4) != 0 || std::memcmp(data.data() + 8, "WAVE", 4) != 0)
+        return false;
+
+    int channels = 0;
+    int bits = 0;
+    std::size_t pos = 12;
+
+    item.name = path;
+
+    while (pos + 8 <= data.size()) {
+        auto chunk_size = static_cast<std::size_t>(read_le(data.data() + pos + 4, 4));
+        auto body = data.data() + pos + 8;
+        chunk_size = std::min(chunk_size, data.size() - pos - 8);
+
+        if (std::memcmp(data.data() + pos, "fmt ", 4) == 0 && chunk_size >= 16) {
+            if (read_le(body, 2) != 1)
+                return false;
+
+            channels = static_cast<int>(read_le(body + 2, 2));
+            item.sample_rate = static_cast<int>(read_le(body + 4, 4));
+            bits = static_cast<int>(read_le(body + 14, 2));
+        } else if (std::memcmp(data.data() + pos, "data", 4) == 0) {
+            if (channels < 1 || bits != 16)
+                return false;
+
+            auto frames = chunk_size / (2 * static_cast<std::size_t>(channels));
+            item.channels.assign(static_cast<std::size_t>(channels), std::vector<float>(frames));
+
+            for (std::size_t i = 0; i < frames; i++) {
+                for (int ch = 0; ch < channels; ch++) {
+                    auto s = static_cast<std::int16_t>(read_le(body + (i * channels + ch) * 2, 2));
+                    item.channels[ch][i] = static_cast<float>(s) / 32768.f;
+                }
+            }
+
+            return true;
+        }
+
+        pos += 8 + chunk_size + (chunk_size & 1);
+    }
+
+    return false;
+}
+
+// Synthetic corpus when no files are given: 8 channels of one minute each,
+// background noise with speech-like bursts, talk time from 5% to 40%.
+static corpus_item make_corpus ()
+{
+    corpus_item item;
+    item.name = "synthetic (8 channels x 60 s)";
+    item.sample_rate = 48000;
+
+    std::mt19937 rng {1};
+    std::size_t const frames = 60 * 48000;
+
+    for (int ch = 0; ch < 8; ch++) {
+        std::normal_distribution<float> noise {0.f, 0.001f};
+        std::vector<float> samples(frames);
+        double talk = 0.05 + 0.05 * ch;
+
+        for (std::size_t i = 0; i < frames; i++) {
+            double t = static_cast<double>(i) / 48000;
+            double phase = std::fmod(t + ch * 0.7, 5.0) / 5.0;
+            float x = noise(rng);
+
+            if (phase < talk) {
+                double envelope = 0.1 * (1 + 0.5 * std::sin(2 * 3.14159265 * 4 * t));
+
+                for (int h = 1; h <= 5; h++)
+                    x += static_cast<float>(envelope / h * std::sin(2 * 3.14159265 * (120 + 10 * ch) * h * t));
+            }
+
+            samples[i] = x;
+        }
+
+        item.channels.push_back(std::move(samples));
+    }
+
+    return item;
+}
+
+// Downstream consumer of the captured blocks: conversion to 16-bit, RTP L16
+// packetization and spectrum analysis (stands for an encoder).
+class downstream
+{
+    rtp::packetizer _packetizer {rtp::PAYLOAD_L16_MONO, 1};
+    audio::spectrum_analyzer _spectrum;
+    std::vector<std::int16_t> _pcm;
+    rtp::packet_buffer _packet;
+
+public:
+    std::uint64_t bytes {0};
+
+public:
+    downstream ()
+        : _spectrum(audio::spectrum_options{})
+        , _pcm(BLOCK_FRAMES)
+    {}
+
+    void consume (float const * samples, std::size_t frames)
+    {
+        for (std::size_t i = 0; i < frames; i++) {
+            auto x = std::max(-1.f, std::min(1.f, samples[i]));
+            _pcm[i] = static_cast<std::int16_t>(std::lround(x * 32767.f));
+        }
+
+        _packetizer.pack_l16(_pcm.data(), frames, 1, _packet);
+        _spectrum.process(samples, frames);
+        bytes += _packet.size;
+    }
+};
+
+using clock_type = std::chrono::steady_clock;
+
+static double msecs_since (clock_type::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+}
+
+static void benchmark (corpus_item const & item)
+{
+    auto frames = item.channels.empty() ? 0 : item.channels[0].size();
+    frames -= frames % BLOCK_FRAMES;
+
+    double seconds = static_cast<double>(frames) / item.sample_rate;
+    double channel_seconds = seconds * static_cast<double>(item.channels.size());
+
+    // Baseline: every block goes downstream
+    double baseline_msecs = 0;
+    std::uint64_t baseline_bytes = 0;
+
+    for (auto const & samples: item.channels) {
+        downstream ds;
+        auto start = clock_type::now();
+
+        for (std::size_t i = 0; i < frames; i += BLOCK_FRAMES)
+            ds.consume(samples.data() + i, BLOCK_FRAMES);
+
+        baseline_msecs += msecs_since(start);
+        baseline_bytes += ds.bytes;
+    }
+
+    // VAD only (to estimate its own cost) and VAD gating downstream
+    double vad_msecs = 0;
+    double gated_msecs = 0;
+    std::uint64_t gated_bytes = 0;
+    std::uint64_t blocks_total = 0;
+    std::uint64_t blocks_voiced = 0;
+
+    audio::vad_options opts;
+    opts.block_frames = BLOCK_FRAMES;
+
+    for (auto const & samples: item.channels) {
+        {
+            audio::voice_activity_detector vad {opts, nullptr};
+            auto start = clock_type::now();
+            vad.process(samples.data(), frames);
+            vad_msecs += msecs_since(start);
+        }
+
+        downstream ds;
+        audio::voice_activity_detector vad {opts, [& ds] (float const * s, std::size_t n, bool) {
+            ds.consume(s, n);
+        }};
+
+        auto start = clock_type::now();
+        vad.process(samples.data(), frames);
+        gated_msecs += msecs_since(start);
+        gated_bytes += ds.bytes;
+        blocks_total += vad.stats().blocks_total;
+        blocks_voiced += vad.stats().blocks_voiced;
+    }
+
+    std::cout << item.name << ": " << item.channels.size() << " channel(s), "
+        << seconds << " s\n";
+    std::cout << "    voiced blocks       : " << 100.0 * blocks_voiced / std::max<std::uint64_t>(blocks_total, 1) << " %\n";
+    std::cout << "    VAD cost            : " << 1000 * vad_msecs / channel_seconds << " us per channel-second\n";
+    std::cout << "    downstream, all     : " << 1000 * baseline_msecs / channel_seconds << " us per channel-second, "
+        << baseline_bytes / 1024 << " KiB\n";
+    std::cout << "    downstream, gated   : " << 1000 * gated_msecs / channel_seconds << " us per channel-second (VAD included), "
+        << gated_bytes / 1024 << " KiB\n";
+    std::cout << "    CPU saved           : " << 100.0 * (1 - gated_msecs / baseline_msecs) << " %\n";
+}
+
+// Usage: vad_benchmark [FILE.wav...]
+//
+// Corpus files are 16-bit PCM WAV files (any channels count, analysis block
+// is 480 frames). Synthetic corpus is used if no files are given.
+int main (int argc, char * argv[])
+{
+    std::cout << std::fixed << std::setprecision(1);
+
+    if (argc < 2) {
+        benchmark(make_corpus());
+        return EXIT_SUCCESS;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        corpus_item item;
+
+        if (!load_wav(argv[i], item)) {
+            std::cerr << argv[i] << ": not a 16-bit PCM WAV file\n";
+            return EXIT_FAILURE;
+        }
+
+        benchmark(item);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,181 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Added optional swscale comparison.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/multimedia/video.hpp"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <initializer_list>
+#include <utility>
+#include <cstdlib>
+
+#if VIDEO_CONVERT_BENCHMARK__SWSCALE_ENABLED
+extern "C" {
+#include <libavutil/pixfmt.h>
+#include <libswscale/swscale.h>
+}
+#endif
+
+using namespace multimedia;
+
+static char const * format_name (video::pixel_format format)
+{
+    switch (format) {
+        case video::pixel_format::i420: return "I420";
+        case video::pixel_format::nv12: return "NV12";
+        case video::pixel_format::yuyv: return "YUYV";
+        case video::pixel_format::rgb24: return "RGB24";
+        case video::pixel_format::rgba: return "RGBA";
+    }
+
+    return "";
+}
+
+template <typename F>
+static double measure_secs (int iterations, F && f)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < iterations; i++)
+        f();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+#if VIDEO_CONVERT_BENCHMARK__SWSCALE_ENABLED
+
+static AVPixelFormat av_format (video::pixel_format format)
+{
+    switch (format) {
+        case video::pixel_format::i420: return AV_PIX_FMT_YUV420P;
+        case video::pixel_format::nv12: return AV_PIX_FMT_NV12;
+        case video::pixel_format::yuyv: return AV_PIX_FMT_YUYV422;
+        case video::pixel_format::rgb24: return AV_PIX_FMT_RGB24;
+        case video::pixel_format::rgba: return AV_PIX_FMT_RGBA;
+    }
+
+    return AV_PIX_FMT_NONE;
+}
+
+// The same conversion by swscale (single-threaded, same size conversions
+// use its unscaled special converters where available). Returns Mpix/s or
+// 0 on failure.
+static double swscale_mpix (video::frame const & src, video::frame & dst, int iterations)
+{
+    auto ctx = sws_getContext(src.width(), src.height(), av_format(src.format())
+        , dst.width(), dst.height(), av_format(dst.format())
+        , SWS_BILINEAR, nullptr, nullptr, nullptr);
+
+    if (ctx == nullptr)
+        return 0;
+
+    // Limited range BT.709 in both directions, as `video::convert()`
+    auto coeffs = sws_getCoefficients(SWS_CS_ITU709);
+    sws_setColorspaceDetails(ctx, coeffs, 0, coeffs, 0, 0, 1 << 16, 1 << 16);
+
+    std::uint8_t const * src_data[4] {};
+    std::uint8_t * dst_data[4] {};
+    int src_stride[4] {};
+    int dst_stride[4] {};
+
+    for (int p = 0; p < src.planes_count(); p++) {
+        src_data[p] = src.data(p);
+        src_stride[p] = static_cast<int>(src.stride(p));
+    }
+
+    for (int p = 0; p < dst.planes_count(); p++) {
+        dst_data[p] = dst.data(p);
+        dst_stride[p] = static_cast<int>(dst.stride(p));
+    }
+
+    auto secs = measure_secs(iterations, [&] {
+        sws_scale(ctx, src_data, src_stride, 0, src.height(), dst_data, dst_stride);
+    });
+
+    sws_freeContext(ctx);
+
+    return static_cast<double>(src.width()) * src.height() * iterations / 1e6 / secs;
+}
+
+#endif // VIDEO_CONVERT_BENCHMARK__SWSCALE_ENABLED
+
+// Usage: video_convert_benchmark [ITERATIONS [THREADS]]
+//
+// THREADS limits number of row bands converted in parallel (default is 1,
+// 0 means choose automatically). Conversions are compared with swscale
+// when built with MULTIMEDIA__ENABLE_FFMPEG.
+int main (int argc, char * argv[])
+{
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 100;
+    std::size_t threads = argc > 2 ? static_cast<std::size_t>(std::atoi(argv[2])) : 1;
+
+    int const width = 1920;
+    int const height = 1080;
+    auto mpix = static_cast<double>(width) * height * iterations / 1e6;
+
+    std::pair<video::pixel_format, video::pixel_format> const conversions[] = {
+          {video::pixel_format::i420, video::pixel_format::rgba}
+        , {video::pixel_format::i420, video::pixel_format::rgb24}
+        , {video::pixel_format::nv12, video::pixel_format::rgba}
+        , {video::pixel_format::yuyv, video::pixel_format::rgb24}
+        , {video::pixel_format::rgba, video::pixel_format::i420}
+        , {video::pixel_format::rgb24, video::pixel_format::nv12}
+        , {video::pixel_format::rgb24, video::pixel_format::yuyv}
+        , {video::pixel_format::yuyv, video::pixel_format::i420}
+        , {video::pixel_format::i420, video::pixel_format::nv12}
+    };
+
+    std::cout << width << "x" << height << ", iterations: " << iterations
+        << ", threads: " << threads << "\n";
+    std::cout << std::fixed << std::setprecision(1);
+
+    for (auto const & c: conversions) {
+        auto src = video::frame::allocate(c.first, width, height);
+        auto dst = video::frame::allocate(c.second, width, height);
+
+        for (int p = 0; p < src.planes_count(); p++) {
+            for (int y = 0; y < src.plane_height(p); y++) {
+                for (std::size_t x = 0; x < src.plane_row_bytes(p); x++)
+                    src.data(p)[y * src.stride(p) + x] = static_cast<std::uint8_t>(x ^ y);
+            }
+        }
+
+        auto secs = measure_secs(iterations, [& src, & dst, threads] {
+            video::convert(src, dst, video::color_space::bt709, threads);
+        });
+
+        std::cout << "    " << std::setw(5) << format_name(c.first) << " -> "
+            << std::setw(5) << format_name(c.second) << ": "
+            << std::setw(8) << mpix / secs << " Mpix/s";
+
+#if VIDEO_CONVERT_BENCHMARK__SWSCALE_ENABLED
+        std::cout << ", swscale: " << std::setw(8) << swscale_mpix(src, dst, iterations) << " Mpix/s";
+#endif
+
+        std::cout << "\n";
+    }
+
+    // Frame handles: acquire from the pool, share with another stage and
+    // release (no allocations when the pool is warm)
+    video::frame_pool pool {video::pixel_format::i420, width, height};
+    int const handles = 1000000;
+    video::frame stage;
+
+    auto secs = measure_secs(handles, [& pool, & stage] {
+        auto f = pool.acquire();
+        stage = f;
+        stage = video::frame{};
+    });
+
+    std::cout << std::setprecision(0);
+    std::cout << "frame_pool: " << handles / secs << " acquire/release per second\n";
+
+    return EXIT_SUCCESS;
+}
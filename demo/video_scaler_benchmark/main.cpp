@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Added cascade pyramid mode.
+//      2026.10.19 Added single pass pyramid mode and source traffic.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/multimedia/video_scaler.hpp"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <cstdint>
+#include <cstdlib>
+
+using namespace multimedia;
+
+static char const * filter_name (video::scale_filter filter)
+{
+    switch (filter) {
+        case video::scale_filter::bilinear: return "bilinear";
+        case video::scale_filter::bicubic: return "bicubic";
+        case video::scale_filter::lanczos: return "lanczos";
+    }
+
+    return "";
+}
+
+template <typename F>
+static double measure_msecs (int iterations, F && f)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < iterations; i++)
+        f();
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+}
+
+// Usage: video_scaler_benchmark [ITERATIONS [THREADS]]
+int main (int argc, char * argv[])
+{
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 50;
+    std::size_t threads = argc > 2 ? static_cast<std::size_t>(std::atoi(argv[2])) : 0;
+
+    int const sizes[][2] = {{1280, 720}, {640, 360}, {320, 180}};
+
+    auto src = video::frame::allocate(video::pixel_format::i420, 1920, 1080);
+
+    for (int p = 0; p < src.planes_count(); p++) {
+        for (int y = 0; y < src.plane_height(p); y++) {
+            for (std::size_t x = 0; x < src.plane_row_bytes(p); x++)
+                src.data(p)[y * src.stride(p) + x] = static_cast<std::uint8_t>(x ^ y);
+        }
+    }
+
+    std::uint64_t source_bytes = 0;
+
+    for (int p = 0; p < src.planes_count(); p++)
+        source_bytes += src.plane_row_bytes(p) * static_cast<std::size_t>(src.plane_height(p));
+
+    video::frame dsts[3];
+
+    for (int i = 0; i < 3; i++)
+        dsts[i] = video::frame::allocate(video::pixel_format::i420, sizes[i][0], sizes[i][1]);
+
+    std::cout << "I420 1920x1080, iterations: " << iterations << "\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    for (auto filter: {video::scale_filter::bilinear, video::scale_filter::bicubic, video::scale_filter::lanczos}) {
+        video::scaler s {filter, threads};
+        std::cout << filter_name(filter) << ":\n";
+
+        for (int i = 0; i < 3; i++) {
+            auto msecs = measure_msecs(iterations, [& s, & src, & dsts, i] { s.scale(src, dsts[i]); });
+            std::cout << "    -> " << sizes[i][0] << "x" << sizes[i][1] << ": " << msecs << " ms\n";
+        }
+
+        std::pair<video::pyramid_mode, char const *> const modes[] = {
+              {video::pyramid_mode::single_pass, "single pass"}
+            , {video::pyramid_mode::direct, "direct"}
+            , {video::pyramid_mode::cascade, "cascade"}
+        };
+
+        for (auto const & m: modes) {
+            auto mode = m.first;
+            auto msecs = measure_msecs(iterations, [& s, & src, & dsts, mode] {
+                s.scale(src, dsts, 3, mode);
+            });
+
+            // Bytes of input rows read per pyramid
+            auto traffic = s.traffic(src, dsts, 3, mode);
+
+            std::cout << "    pyramid " << std::setw(11) << std::left << m.second << std::right
+                << " (720p, 360p, 180p): " << msecs << " ms, source read "
+                << static_cast<double>(traffic.source_bytes) / source_bytes << " times ("
+                << static_cast<double>(traffic.source_bytes) / 1e6 << " MB)";
+
+            if (traffic.level_bytes > 0)
+                std::cout << ", levels read " << static_cast<double>(traffic.level_bytes) / 1e6 << " MB";
+
+            std::cout << "\n";
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Alignment controller gains, documented jitter limit.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "exports.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace multimedia {
+namespace audio {
+
+struct aggregate_device
+{
+    std::string name; // `device_info::name` of the source
+    int channels;
+};
+
+struct aggregate_options
+{
+    // Nominal sample rate of all devices.
+    double sample_rate {48000};
+
+    // Maximum number of frames in a single written fragment.
+    std::size_t max_frames {4800};
+
+    // Delay of the output relative to the master device, gives time for
+    // fragments of the other devices to arrive.
+    std::size_t latency_frames {2400};
+
+    // Capacity of the per device input rings and of the output ring.
+    std::size_t input_ring_frames {32768};
+    std::size_t output_ring_frames {32768};
+
+    // Alignment error (frames) at which a device is realigned by dropping
+    // frames or inserting silence instead of resampling.
+    std::size_t realign_threshold_frames {2400};
+
+    // Drift correction parameters, see `drift_options`. Controller is fed
+    // with the alignment error, which is much smaller than the latency error
+    // of the playback drift compensation, hence the higher gains.
+    double max_correction_ppm {1000};
+    double kp {100.0};
+    double ki {1.0};
+    std::size_t window {256};
+};
+
+struct aggregate_stats
+{
+    double drift_ppm {0};              // Device clock deviation from nominal rate
+    double ratio {1.0};                // Current resampling ratio to master clock
+    double alignment_error {0};        // Last alignment error (frames)
+    std::uint64_t overrun_frames {0};  // Frames lost due to full input ring, replaced by silence (output ring for device 0)
+    std::uint64_t underrun_frames {0}; // Silence emitted due to late fragments
+    std::uint64_t realignments {0};
+};
+
+// Aggregates capture of several input devices (e.g. USB microphones of one
+// array) into a single stream of interleaved multi-device frames (channels
+// of device 0, then channels of device 1, etc.).
+//
+// Each device writes captured fragments from its own capture thread along
+// with capture time of the first frame of the fragment (for PulseAudio it
+// is `timestamp` of the stream timing info minus the source latency).
+// Device 0 is the master clock: its fragments drive the assembly. Other
+// devices are aligned to the master by timestamps and resampled to the
+// master clock with per device drift correction. Assembled frames are
+// delivered through the lock-free ring (single reader).
+//
+// Alignment accuracy is limited by the jitter of the timestamps: clock lines
+// fitted over `window` fragments smooth it out, but the residual error of
+// the fit moves the alignment. With default options and 10 ms fragments at
+// 48 kHz devices stay aligned within about 3 frames for 300 us timestamp
+// jitter and within about 10 frames for 1 ms jitter. Timestamps derived
+// from the device timing info are much more accurate than the time of
+// return from a blocking read.
+class aggregate_input final
+{
+    class impl;
+    std::unique_ptr<impl> _d;
+
+public:
+    MULTIMEDIA__EXPORT aggregate_input (std::vector<aggregate_device> const & devices
+        , aggregate_options const & opts = aggregate_options{});
+    MULTIMEDIA__EXPORT ~aggregate_input ();
+
+    aggregate_input (aggregate_input const &) = delete;
+    aggregate_input & operator = (aggregate_input const &) = delete;
+
+    MULTIMEDIA__EXPORT std::size_t devices_count () const;
+    MULTIMEDIA__EXPORT aggregate_device const & device (std::size_t index) const;
+
+    // Total number of channels of the aggregated frames.
+    MULTIMEDIA__EXPORT int channels () const;
+
+    // Writes fragment of interleaved samples captured by device `index`,
+    // `time_usec` is the capture time of the first frame (any monotonic
+    // clock common to all devices). Only one thread may write to a given
+    // device. Never blocks and does not allocate. Returns false if index
+    // is invalid or fragment is too large.
+    MULTIMEDIA__EXPORT bool write (std::size_t index
+        , float const * samples
+        , std::size_t frames
+        , std::int64_t time_usec);
+
+    // Reads up to `max_frames` aggregated frames. Never blocks, returns
+    // number of frames read.
+    MULTIMEDIA__EXPORT std::size_t read (float * frames, std::size_t max_frames);
+
+    // Number of aggregated frames available for reading.
+    MULTIMEDIA__EXPORT std::size_t available () const;
+
+    // Safe to call from any thread.
+    MULTIMEDIA__EXPORT aggregate_stats stats (std::size_t index) const;
+};
+
+}} // namespace multimedia::audio
@@ -5,11 +5,17 @@
 //
 // Changelog:
 //      2021.08.03 Initial version.
+//      2026.10.19 Added asynchronous device queries.
+//      2026.10.19 Added device control operations.
+//      2026.10.19 Added sequential execution of device control operations.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include "error.hpp"
 #include "exports.hpp"
+#include <functional>
 #include <string>
 #include <vector>
+#include <cstddef>
 
 namespace multimedia {
 namespace audio {
@@ -30,4 +36,113 @@ MULTIMEDIA__EXPORT device_info default_input_device ();  // default source/input
 MULTIMEDIA__EXPORT device_info default_output_device (); // default sink/output device
 MULTIMEDIA__EXPORT std::vector<device_info> fetch_devices (device_mode mode);
 
+// Asynchronous versions of the device queries. With PulseAudio backend
+// requests share one connection served by the single event loop thread
+// and `callback` is called from that thread. Other backends complete the
+// request before return (callback is called from the calling thread).
+// Empty result is passed on failure. Coroutine interface is in
+// `audio_coro.hpp`.
+MULTIMEDIA__EXPORT void default_input_device_async (std::function<void (device_info)> callback);
+MULTIMEDIA__EXPORT void default_output_device_async (std::function<void (device_info)> callback);
+MULTIMEDIA__EXPORT void fetch_devices_async (device_mode mode
+    , std::function<void (std::vector<device_info>)> callback);
+
+// Batch of device control operations (volume, mute, default device) to
+// execute together. Devices are specified by `device_info::name`. With
+// PulseAudio backend all operations are sent through one connection and
+// are awaited together (or one by one with `execution::sequential`).
+class control_batch final
+{
+public:
+    enum class execution
+    {
+          pipelined  // Issue all operations, then wait for all of them
+        , sequential // Issue next operation after completion of previous one
+    };
+
+    enum class operation_type
+    {
+          volume
+        , mute
+        , default_device
+    };
+
+    struct operation
+    {
+        operation_type type;
+        device_mode mode;
+        std::string name;
+        float volume;
+        bool mute;
+    };
+
+private:
+    std::vector<operation> _ops;
+
+public:
+    // Volume is relative to the nominal (100%) device volume and is applied
+    // to all channels. Values above 1.0 amplify if supported by backend.
+    control_batch & set_volume (device_mode mode, std::string const & name, float volume)
+    {
+        _ops.push_back(operation{operation_type::volume, mode, name, volume, false});
+        return *this;
+    }
+
+    control_batch & set_mute (device_mode mode, std::string const & name, bool mute)
+    {
+        _ops.push_back(operation{operation_type::mute, mode, name, 0.f, mute});
+        return *this;
+    }
+
+    // Makes device the default sink (output) or source (input).
+    control_batch & set_default_device (device_mode mode, std::string const & name)
+    {
+        _ops.push_back(operation{operation_type::default_device, mode, name, 0.f, false});
+        return *this;
+    }
+
+    std::vector<operation> const & operations () const noexcept
+    {
+        return _ops;
+    }
+
+    std::size_t size () const noexcept
+    {
+        return _ops.size();
+    }
+
+    void clear ()
+    {
+        _ops.clear();
+    }
+
+    // Executes queued operations and waits for completion of all of them.
+    // Returns false and sets `ec` to the first error if any operation failed
+    // (the rest of operations are executed anyway). The batch is cleared.
+    MULTIMEDIA__EXPORT bool execute (execution mode, error_code & ec);
+
+    bool execute (error_code & ec)
+    {
+        return execute(execution::pipelined, ec);
+    }
+};
+
+inline bool set_volume (device_mode mode, std::string const & name, float volume
+    , error_code & ec)
+{
+    return control_batch{}.set_volume(mode, name, volume).execute(ec);
+}
+
+inline bool set_mute (device_mode mode, std::string const & name, bool mute
+    , error_code & ec)
+{
+    return control_batch{}.set_mute(mode, name, mute).execute(ec);
+}
+
+inline bool set_default_device (device_mode mode, std::string const & name
+    , error_code & ec)
+{
+    return control_batch{}.set_default_device(mode, name).execute(ec);
+}
+
 }} // namespace multimedia::audio
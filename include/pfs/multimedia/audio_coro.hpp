@@ -0,0 +1,120 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Fixed use of the awaitable after the coroutine resumption.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "audio.hpp"
+
+// Coroutine interface is header only and available when the user code is
+// compiled with coroutines support (C++20). The library itself is built as
+// C++11 and provides callback based asynchronous API only.
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+#include <atomic>
+#include <coroutine>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace multimedia {
+namespace audio {
+
+// Resumes suspended coroutine, e.g. by posting it to the user scheduler.
+// Empty executor resumes coroutine directly from the thread that completed
+// the request (the backend event loop thread).
+using executor = std::function<void (std::coroutine_handle<>)>;
+
+// Awaitable adapter of the callback based asynchronous request.
+template <typename T>
+class async_request final
+{
+public:
+    using callback_type = std::function<void (T)>;
+    using starter_type = std::function<void (callback_type)>;
+
+private:
+    starter_type _start;
+    executor _executor;
+    T _result {};
+    std::coroutine_handle<> _handle;
+
+    // Set by the first of `await_suspend()` and completion callback, the
+    // second one resumes the coroutine (or continues without suspension).
+    std::atomic<bool> _arrived {false};
+
+public:
+    async_request (starter_type start, executor ex)
+        : _start(std::move(start))
+        , _executor(std::move(ex))
+    {}
+
+    async_request (async_request const &) = delete;
+    async_request & operator = (async_request const &) = delete;
+
+    bool await_ready () const noexcept
+    {
+        return false;
+    }
+
+    bool await_suspend (std::coroutine_handle<> h)
+    {
+        _handle = h;
+
+        _start([this] (T result) {
+            // Once the flag is exchanged the coroutine may be resumed by
+            // another thread and destroy the awaitable (it lives in the
+            // coroutine frame), so members are not accessed after that
+            auto ex = std::move(_executor);
+            auto handle = _handle;
+            _result = std::move(result);
+
+            if (_arrived.exchange(true, std::memory_order_acq_rel)) {
+                if (ex)
+                    ex(handle);
+                else
+                    handle.resume();
+            }
+        });
+
+        // Request completed synchronously: do not suspend
+        return !_arrived.exchange(true, std::memory_order_acq_rel);
+    }
+
+    T await_resume ()
+    {
+        return std::move(_result);
+    }
+};
+
+inline async_request<device_info> default_input_device_co (executor ex = executor{})
+{
+    return async_request<device_info>{[] (async_request<device_info>::callback_type cb) {
+        default_input_device_async(std::move(cb));
+    }, std::move(ex)};
+}
+
+inline async_request<device_info> default_output_device_co (executor ex = executor{})
+{
+    return async_request<device_info>{[] (async_request<device_info>::callback_type cb) {
+        default_output_device_async(std::move(cb));
+    }, std::move(ex)};
+}
+
+inline async_request<std::vector<device_info>> fetch_devices_co (device_mode mode
+    , executor ex = executor{})
+{
+    using request_type = async_request<std::vector<device_info>>;
+
+    return request_type{[mode] (request_type::callback_type cb) {
+        fetch_devices_async(mode, std::move(cb));
+    }, std::move(ex)};
+}
+
+}} // namespace multimedia::audio
+
+#endif // __cpp_impl_coroutine
@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "encoder_pipeline.hpp"
+#include "error.hpp"
+#include "exports.hpp"
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+namespace multimedia {
+namespace audio {
+
+#if MULTIMEDIA__OPUS_ENABLED
+
+enum class opus_application
+{
+      voip       // Speech, best intelligibility
+    , audio      // Music or mixed content, best fidelity
+    , low_delay  // Lowest algorithmic delay (no speech modes)
+};
+
+struct opus_encoder_options
+{
+    // One of 8000, 12000, 16000, 24000 or 48000.
+    int sample_rate {48000};
+
+    // 1 or 2.
+    int channels {2};
+
+    opus_application application {opus_application::audio};
+
+    // Bits per second, 0 means codec default.
+    std::int32_t bitrate {0};
+
+    // Range [0, 10].
+    int complexity {10};
+
+    // Packet duration in frames: 2.5, 5, 10, 20, 40 or 60 ms (960 frames is
+    // 20 ms at 48 kHz).
+    std::size_t frame_size {960};
+};
+
+// Creates libopus encoder for `encoder_pipeline`. Submitted fragments of any
+// length are buffered into `frame_size` packets, the incomplete last packet
+// is padded with silence on flush. Packets are raw Opus packets (no Ogg
+// encapsulation), suitable for RTP (see `rtp::packetizer`). Returns
+// `nullptr` and sets `ec` on invalid options or libopus failure.
+MULTIMEDIA__EXPORT std::unique_ptr<encoder> make_opus_encoder (opus_encoder_options const & opts
+    , error_code & ec);
+
+#endif // MULTIMEDIA__OPUS_ENABLED
+
+#if MULTIMEDIA__FLAC_ENABLED
+
+struct flac_encoder_options
+{
+    int sample_rate {48000};
+
+    // Range [1, 8].
+    int channels {2};
+
+    // 16 or 24.
+    int bits_per_sample {16};
+
+    // Range [0, 8].
+    int compression_level {5};
+
+    // Frames per FLAC frame, 0 means the compression level default (4096).
+    std::size_t block_size {0};
+};
+
+// Creates libFLAC encoder for `encoder_pipeline`. Packets form a native FLAC
+// stream: the first packet (pts 0) is the stream header, each following
+// packet is one FLAC frame, pts is the index of its first frame in the
+// stream. STREAMINFO is not rewritten at the end (total length and MD5 are
+// unknown), as for any streamed FLAC. Returns `nullptr` and sets `ec` on
+// invalid options or libFLAC failure.
+MULTIMEDIA__EXPORT std::unique_ptr<encoder> make_flac_encoder (flac_encoder_options const & opts
+    , error_code & ec);
+
+#endif // MULTIMEDIA__FLAC_ENABLED
+
+}} // namespace multimedia::audio
@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Moved into `multimedia::video` namespace.
+//      2026.10.19 Intrusive reference counting of decoded frames.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "error.hpp"
+#include "exports.hpp"
+#include <memory>
+#include <string>
+#include <cstddef>
+
+#if MULTIMEDIA__FFMPEG_ENABLED
+
+struct AVFrame;
+
+namespace multimedia {
+namespace video {
+
+enum class media_type
+{
+      audio
+    , video
+};
+
+struct decoded_frame_buffer;
+
+// Decoded audio or video frame: cheap handle to the `AVFrame` borrowed from
+// the pipeline frame pool (reference counter is stored in the pooled entry,
+// so handles never allocate). Frame returns to the pool when the last handle
+// is destroyed. Frames may outlive the pipeline.
+class decoded_frame final
+{
+    decoded_frame_buffer * _buffer {nullptr};
+    media_type _type {media_type::video};
+    double _time {0};
+
+public:
+    decoded_frame () = default;
+
+    // Takes ownership of the `buffer` reference (used by the pipeline).
+    MULTIMEDIA__EXPORT decoded_frame (decoded_frame_buffer * buffer, media_type type, double time);
+    MULTIMEDIA__EXPORT decoded_frame (decoded_frame const & other);
+    MULTIMEDIA__EXPORT decoded_frame (decoded_frame && other) noexcept;
+    MULTIMEDIA__EXPORT decoded_frame & operator = (decoded_frame const & other);
+    MULTIMEDIA__EXPORT decoded_frame & operator = (decoded_frame && other) noexcept;
+    MULTIMEDIA__EXPORT ~decoded_frame ();
+
+    bool empty () const noexcept
+    {
+        return _buffer == nullptr;
+    }
+
+    media_type type () const noexcept
+    {
+        return _type;
+    }
+
+    // Presentation time in seconds.
+    double time () const noexcept
+    {
+        return _time;
+    }
+
+    MULTIMEDIA__EXPORT AVFrame * native () const noexcept;
+};
+
+struct stream_info
+{
+    bool present {false};
+    std::string codec_name;
+    int sample_rate {0}; // Audio only
+    int channels {0};    // Audio only
+    int width {0};       // Video only
+    int height {0};      // Video only
+};
+
+struct decode_options
+{
+    bool enable_audio {true};
+    bool enable_video {true};
+
+    // Decoder (frame and slice) threads per stream, 0 means choose
+    // automatically.
+    int decoder_threads {0};
+
+    // Capacities of the queues between stages (per stream).
+    std::size_t packet_queue_size {128};
+    std::size_t frame_queue_size {8};
+};
+
+// Media file decoding pipeline: demuxer thread -> packet queue -> decoder
+// thread (per stream) -> frame queue -> `read()` called by output stage
+// (e.g. playback thread of the audio device). Queues are bounded, so the
+// pipeline runs ahead of the output at most by the queue capacities. All
+// enabled streams must be read, otherwise the demuxer stalls when the
+// packet queue of unread stream fills up.
+class decode_pipeline final
+{
+    class impl;
+    std::unique_ptr<impl> _d;
+
+public:
+    MULTIMEDIA__EXPORT decode_pipeline ();
+    MULTIMEDIA__EXPORT ~decode_pipeline ();
+
+    decode_pipeline (decode_pipeline const &) = delete;
+    decode_pipeline & operator = (decode_pipeline const &) = delete;
+
+    // Opens media file and starts the pipeline threads.
+    MULTIMEDIA__EXPORT bool open (std::string const & path
+        , decode_options const & opts
+        , error_code & ec);
+
+    // Stops the pipeline threads and releases the resources.
+    MULTIMEDIA__EXPORT void close ();
+
+    MULTIMEDIA__EXPORT bool is_open () const noexcept;
+
+    // Duration in seconds (0 if unknown).
+    MULTIMEDIA__EXPORT double duration () const;
+
+    MULTIMEDIA__EXPORT stream_info info (media_type type) const;
+
+    // Waits for the next decoded frame of the stream. Returns false at the
+    // end of the stream (until seek), if the stream is absent or disabled,
+    // or if the pipeline is closed.
+    MULTIMEDIA__EXPORT bool read (media_type type, decoded_frame & frame);
+
+    // Requests seek to `seconds`. Frames decoded before the seek are
+    // discarded: the next `read()` returns frames from the new position.
+    MULTIMEDIA__EXPORT bool seek (double seconds);
+};
+
+}} // namespace multimedia::video
+
+#endif // MULTIMEDIA__FFMPEG_ENABLED
@@ -0,0 +1,163 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Added fitted clock line mapping.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "exports.hpp"
+#include "resampler.hpp"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace multimedia {
+namespace audio {
+
+// Device clock observation: number of frames passed through the device by
+// the moment `time_usec`. For PulseAudio it is obtained from the stream
+// timing info (`pa_stream_get_timing_info()`): `timestamp` and
+// `read_index` (source) / `write_index` (sink) divided by frame size.
+struct clock_sample
+{
+    std::int64_t  time_usec;
+    std::uint64_t frames;
+};
+
+// Estimates actual sample rate of the device clock by least squares fit
+// of the last `window` clock samples.
+class clock_drift_estimator final
+{
+    double _nominal_rate;
+    std::vector<clock_sample> _samples; // Ring buffer
+    std::size_t _head {0};
+    std::size_t _count {0};
+    double _rate;
+
+    // Fitted line: frames = _origin.frames + _offset + _rate * (time - _origin.time)
+    clock_sample _origin {0, 0};
+    double _offset {0};
+
+public:
+    MULTIMEDIA__EXPORT clock_drift_estimator (double nominal_rate, std::size_t window = 256);
+
+    MULTIMEDIA__EXPORT void update (clock_sample const & sample);
+    MULTIMEDIA__EXPORT void reset ();
+
+    // Estimated rate (frames per second), nominal rate until at least two
+    // samples received.
+    double rate () const noexcept
+    {
+        return _rate;
+    }
+
+    // Frames count at `time_usec` on the fitted clock line, smooths out
+    // jitter of the individual clock samples.
+    double frames_at (std::int64_t time_usec) const noexcept
+    {
+        return static_cast<double>(_origin.frames) + _offset
+            + static_cast<double>(time_usec - _origin.time_usec) * 1e-6 * _rate;
+    }
+
+    // Inverse of `frames_at()`.
+    std::int64_t time_at (double frames) const noexcept
+    {
+        double frames_delta = frames - static_cast<double>(_origin.frames) - _offset;
+        return _origin.time_usec + static_cast<std::int64_t>(frames_delta / _rate * 1e6);
+    }
+
+    double nominal_rate () const noexcept
+    {
+        return _nominal_rate;
+    }
+
+    // Deviation from the nominal rate in parts per million.
+    double drift_ppm () const noexcept
+    {
+        return (_rate / _nominal_rate - 1.0) * 1e6;
+    }
+};
+
+struct drift_options
+{
+    int channels {2};
+
+    // Nominal sample rate of both devices.
+    double sample_rate {48000};
+
+    // Latency (frames queued between capture and playback) to keep.
+    std::size_t target_latency_frames {4800};
+
+    // Limit of the total ratio correction.
+    double max_correction_ppm {1000};
+
+    // Latency controller coefficients (correction in ppm per millisecond
+    // of latency error and per millisecond accumulated on each update).
+    double kp {5.0};
+    double ki {0.05};
+
+    // Number of clock samples used for rate estimation.
+    std::size_t window {256};
+};
+
+// Adaptive drift compensation between capture and playback devices.
+// Rate ratio of the devices is estimated from their clock samples and
+// corrected by the latency controller, so the queued latency stays constant.
+// Captured frames are resampled to the playback device clock.
+class drift_compensator final
+{
+    drift_options _opts;
+    clock_drift_estimator _input_clock;
+    clock_drift_estimator _output_clock;
+    fine_resampler _resampler;
+    double _integral {0};
+    double _correction {1.0};
+
+private:
+    void update_ratio ();
+
+public:
+    MULTIMEDIA__EXPORT drift_compensator (drift_options const & opts);
+
+    MULTIMEDIA__EXPORT void update_input_clock (clock_sample const & sample);
+    MULTIMEDIA__EXPORT void update_output_clock (clock_sample const & sample);
+
+    // Report current number of frames queued between the devices
+    // (ring buffer fill plus playback stream latency).
+    MULTIMEDIA__EXPORT void update_latency (std::size_t queued_frames);
+
+    std::size_t output_frames_max (std::size_t input_frames) const
+    {
+        return _resampler.output_frames_max(input_frames);
+    }
+
+    // Resample captured frames to playback device clock, see
+    // `fine_resampler::process()`.
+    std::size_t process (float const * input, std::size_t input_frames, float * output)
+    {
+        return _resampler.process(input, input_frames, output);
+    }
+
+    // Current resampling ratio (output rate / input rate).
+    double ratio () const noexcept
+    {
+        return _resampler.ratio();
+    }
+
+    clock_drift_estimator const & input_clock () const noexcept
+    {
+        return _input_clock;
+    }
+
+    clock_drift_estimator const & output_clock () const noexcept
+    {
+        return _output_clock;
+    }
+
+    MULTIMEDIA__EXPORT void reset ();
+};
+
+}} // namespace multimedia::audio
@@ -0,0 +1,176 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Lock-free run queues and wake up on the submit path.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "exports.hpp"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace multimedia {
+
+class semaphore;
+
+namespace audio {
+
+// Encoded packet delivered to the sink.
+struct encoded_packet
+{
+    int stream;                // Stream identifier returned by `add_stream()`
+    std::uint8_t const * data;
+    std::size_t size;
+    std::uint64_t pts;         // Index of the first frame (per stream)
+};
+
+// Called by encoder for each produced packet: data, size, pts.
+using packet_emitter = std::function<void (std::uint8_t const *, std::size_t, std::uint64_t)>;
+
+// Codec adapter interface (e.g. Opus for real-time or FLAC for archival
+// encoding). Methods are called from worker threads, but never concurrently
+// for the same encoder.
+class encoder
+{
+public:
+    virtual ~encoder () {}
+
+    // Encode interleaved float samples, `pts` is the index of the first frame.
+    virtual void encode (float const * samples
+        , std::size_t frames
+        , std::uint64_t pts
+        , packet_emitter const & emit) = 0;
+
+    // Emit buffered data at the end of stream.
+    virtual void flush (packet_emitter const & emit)
+    {
+        (void)emit;
+    }
+};
+
+struct encoder_pipeline_options
+{
+    // Number of worker threads, 0 means hardware concurrency.
+    std::size_t threads {0};
+
+    // Maximum number of streams.
+    std::size_t max_streams {256};
+
+    // Capacity of the per stream queue (fragments).
+    std::size_t queue_capacity {64};
+
+    // Maximum number of frames in a single submitted fragment.
+    std::size_t max_frames {4800};
+
+    // Number of fragments encoded for one stream before the worker switches
+    // to another stream (fairness).
+    std::size_t batch {8};
+};
+
+struct lane_stats
+{
+    std::uint64_t submitted {0};
+    std::uint64_t encoded {0};
+    std::uint64_t rejected {0};    // Fragments dropped due to full queue
+    std::size_t queued {0};        // Current queue depth
+    std::size_t high_watermark {0};
+};
+
+// Encoding pipeline running encoders off the capture thread. Each stream
+// is an ordered lane with bounded queue: fragments of one stream are
+// encoded sequentially and in order, different streams are encoded in
+// parallel by worker threads. Workers have own lock-free run queues and
+// steal lanes from each other when idle.
+class encoder_pipeline final
+{
+public:
+    using sink_type = std::function<void (encoded_packet const &)>;
+
+private:
+    struct fragment
+    {
+        std::vector<float> samples;
+        std::size_t frames {0};
+        std::uint64_t pts {0};
+    };
+
+    struct lane
+    {
+        int id;
+        int channels;
+        std::unique_ptr<encoder> enc;
+        packet_emitter emit;
+
+        // Single producer / single consumer ring
+        std::vector<fragment> ring;
+        std::atomic<std::size_t> head {0};
+        std::atomic<std::size_t> tail {0};
+
+        // Lane is in some run queue or processed by a worker
+        std::atomic<bool> scheduled {false};
+
+        std::uint64_t next_pts {0};
+        std::atomic<std::uint64_t> submitted {0};
+        std::atomic<std::uint64_t> encoded {0};
+        std::atomic<std::uint64_t> rejected {0};
+        std::atomic<std::size_t> high_watermark {0};
+    };
+
+    struct worker;
+
+    encoder_pipeline_options _opts;
+    sink_type _sink;
+
+    std::vector<std::unique_ptr<lane>> _lanes;
+    std::atomic<std::size_t> _lane_count {0};
+    std::mutex _lanes_mtx;
+
+    std::vector<std::unique_ptr<worker>> _workers;
+    std::atomic<std::size_t> _next_worker {0};
+    std::atomic<bool> _stopped {false};
+
+    // Counts lanes in run queues, idle workers wait on it
+    std::unique_ptr<semaphore> _ready;
+    std::atomic<std::size_t> _queued {0};
+
+private:
+    void schedule (lane * l, std::size_t worker_index);
+    lane * take (std::size_t worker_index);
+    void run (std::size_t worker_index);
+    void process (lane * l, std::size_t worker_index);
+
+public:
+    MULTIMEDIA__EXPORT encoder_pipeline (encoder_pipeline_options const & opts, sink_type sink);
+
+    // Stops the pipeline, see `stop()`.
+    MULTIMEDIA__EXPORT ~encoder_pipeline ();
+
+    encoder_pipeline (encoder_pipeline const &) = delete;
+    encoder_pipeline & operator = (encoder_pipeline const &) = delete;
+
+    // Adds a stream, returns its identifier or -1 if maximum number of
+    // streams reached.
+    MULTIMEDIA__EXPORT int add_stream (std::unique_ptr<encoder> enc, int channels);
+
+    // Queues fragment of interleaved samples for encoding. Safe to call from
+    // the capture callback: never blocks and does not allocate. Only one
+    // thread may submit to a given stream. Returns false if the stream
+    // queue is full (fragment is dropped and counted as rejected) or
+    // fragment is too large.
+    MULTIMEDIA__EXPORT bool submit (int stream, float const * samples, std::size_t frames);
+
+    MULTIMEDIA__EXPORT lane_stats stats (int stream) const;
+
+    // Encodes all queued fragments, flushes encoders and joins workers.
+    MULTIMEDIA__EXPORT void stop ();
+};
+
+}} // namespace multimedia::audio
@@ -5,6 +5,7 @@
 //
 // Changelog:
 //      2021.08.05 Initial version.
+//      2026.10.19 Added `backend_error`.
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include <system_error>
@@ -19,6 +20,7 @@ using error_code = std::error_code;
 enum class errc
 {
       success = 0
+    , backend_error // Error reported by backend library (e.g. FFmpeg)
 };
 
 class error_category : public std::error_category
@@ -35,6 +37,9 @@ public:
             case static_cast<int>(errc::success):
                 return std::string{"no error"};
 
+            case static_cast<int>(errc::backend_error):
+                return std::string{"backend error"};
+
             default: return std::string{"unknown net error"};
         }
     }
@@ -0,0 +1,57 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "exports.hpp"
+#include <vector>
+#include <cstddef>
+
+namespace multimedia {
+namespace audio {
+
+// Streaming resampler for ratios close to 1.0 (clock drift compensation,
+// sample alignment). Uses 4-point cubic Hermite interpolation on
+// interleaved float samples. Ratio may be changed between calls without
+// discontinuities. Instance is not thread-safe.
+class fine_resampler final
+{
+    int _channels {1};
+    double _ratio {1.0};        // Output rate / input rate
+    double _pos {1.0};          // Fractional read position in `_buffer` (frames)
+    std::vector<float> _buffer; // Unconsumed input with one frame of history
+
+public:
+    MULTIMEDIA__EXPORT fine_resampler (int channels, double ratio = 1.0);
+
+    MULTIMEDIA__EXPORT void set_ratio (double ratio);
+
+    double ratio () const noexcept
+    {
+        return _ratio;
+    }
+
+    int channels () const noexcept
+    {
+        return _channels;
+    }
+
+    // Upper bound of output frames count for `input_frames` input frames
+    // at current ratio.
+    MULTIMEDIA__EXPORT std::size_t output_frames_max (std::size_t input_frames) const;
+
+    // Consumes all `input_frames` of input and writes resampled frames into
+    // `output` (must have room for `output_frames_max(input_frames)` frames).
+    // Returns number of frames written.
+    MULTIMEDIA__EXPORT std::size_t process (float const * input
+        , std::size_t input_frames
+        , float * output);
+
+    MULTIMEDIA__EXPORT void reset ();
+};
+
+}} // namespace multimedia::audio
@@ -0,0 +1,284 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// References:
+//      1. RTP: A Transport Protocol for Real-Time Applications (RFC 3550).
+//      2. RTP Profile for Audio and Video Conferences (RFC 3551), L16 payload.
+//      3. RTP Payload Format for the Opus Speech and Audio Codec (RFC 7587).
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Added payload clock rate and socket error reporting.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "error.hpp"
+#include "exports.hpp"
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace multimedia {
+namespace rtp {
+
+constexpr std::size_t HEADER_SIZE = 12;
+
+// Maximum datagram size handled by packet buffers (fits Ethernet MTU).
+constexpr std::size_t PACKET_SIZE_MAX = 1500;
+
+// Static payload types (RFC 3551) and conventional dynamic one for Opus.
+constexpr std::uint8_t PAYLOAD_L16_STEREO = 10; // 44100 Hz, 2 channels
+constexpr std::uint8_t PAYLOAD_L16_MONO   = 11; // 44100 Hz, 1 channel
+constexpr std::uint8_t PAYLOAD_OPUS       = 111; // 48000 Hz clock (RFC 7587)
+
+// RTP clock rate (samples per second) of the payload types above, 0 for
+// other payload types (their clock rate is negotiated out of band).
+MULTIMEDIA__EXPORT std::uint32_t payload_clock_rate (std::uint8_t payload_type);
+
+struct header
+{
+    std::uint8_t  payload_type {0};
+    bool          marker {false};
+    std::uint16_t sequence {0};
+    std::uint32_t timestamp {0};
+    std::uint32_t ssrc {0};
+};
+
+struct packet_buffer
+{
+    std::uint8_t data[PACKET_SIZE_MAX];
+    std::size_t  size {0};
+};
+
+// Writes fixed 12-byte header into `out`, returns HEADER_SIZE.
+MULTIMEDIA__EXPORT std::size_t serialize_header (header const & h, std::uint8_t * out);
+
+// Parses RTP packet skipping CSRC list, header extension and padding.
+// Returns false if packet is malformed or has wrong version.
+MULTIMEDIA__EXPORT bool parse (std::uint8_t const * data
+    , std::size_t size
+    , header & h
+    , std::uint8_t const ** payload
+    , std::size_t * payload_size);
+
+// L16 payload: signed 16-bit samples in network byte order.
+MULTIMEDIA__EXPORT void encode_l16 (std::int16_t const * samples
+    , std::size_t count
+    , std::uint8_t * out);
+
+MULTIMEDIA__EXPORT void decode_l16 (std::uint8_t const * payload
+    , std::size_t count
+    , std::int16_t * samples);
+
+// Maintains sequence number and timestamp of the outgoing stream. Payload
+// is opaque for the packetizer: L16 (see `encode_l16()`) or encoded Opus
+// packet.
+class packetizer final
+{
+    header _header;
+
+public:
+    MULTIMEDIA__EXPORT packetizer (std::uint8_t payload_type
+        , std::uint32_t ssrc
+        , std::uint16_t initial_sequence = 0
+        , std::uint32_t initial_timestamp = 0);
+
+    // Packs payload into `out`, `duration` is the payload duration in
+    // timestamp units (samples per channel at RTP clock rate).
+    // Returns false if payload does not fit the packet buffer.
+    MULTIMEDIA__EXPORT bool pack (std::uint8_t const * payload
+        , std::size_t size
+        , std::uint32_t duration
+        , packet_buffer & out
+        , bool marker = false);
+
+    // Packs `frames` interleaved samples as L16 payload.
+    MULTIMEDIA__EXPORT bool pack_l16 (std::int16_t const * samples
+        , std::size_t frames
+        , int channels
+        , packet_buffer & out
+        , bool marker = false);
+
+    header const & next_header () const noexcept
+    {
+        return _header;
+    }
+};
+
+enum class playout_status
+{
+      ok        // Packet delivered
+    , lost      // Packet is missing, concealment required
+    , buffering // Not enough packets buffered yet, output silence
+};
+
+struct jitter_buffer_options
+{
+    // RTP clock rate (samples per second), must match the payload type of
+    // the stream, see `payload_clock_rate()` (e.g. 44100 for L16 static
+    // payload types). Default is the Opus clock rate.
+    std::uint32_t clock_rate {48000};
+
+    // Packet duration in timestamp units (e.g. 960 for 20 ms at 48 kHz).
+    std::uint32_t packet_duration {960};
+
+    // Limits of the adaptive target latency (packets).
+    std::size_t min_packets {1};
+    std::size_t max_packets {50};
+
+    // Target latency in multiples of the interarrival jitter estimate.
+    double jitter_factor {3.0};
+
+    // Number of slots, rounded up to power of two (max buffered packets).
+    std::size_t capacity {256};
+};
+
+struct jitter_buffer_stats
+{
+    std::uint64_t received {0};
+    std::uint64_t played {0};
+    std::uint64_t lost {0};       // Concealed packets
+    std::uint64_t late {0};       // Arrived after their playout time
+    std::uint64_t duplicated {0};
+    std::uint64_t dropped {0};    // Dropped to reduce latency or on overflow
+    double jitter {0};            // RFC 3550 interarrival jitter (timestamp units)
+};
+
+// Adaptive jitter buffer. Packets are stored in preallocated slots indexed
+// by sequence number. Target latency follows the RFC 3550 interarrival
+// jitter estimate. Playout is driven by the caller (playback clock),
+// one packet per `pop()` call. Instance is not thread-safe.
+class jitter_buffer final
+{
+    struct slot
+    {
+        bool          occupied {false};
+        header        hdr;
+        packet_buffer payload;
+    };
+
+    jitter_buffer_options _opts;
+    std::vector<slot> _slots;
+    std::size_t _mask {0};
+
+    bool _playing {false};
+    bool _has_expected {false};
+    std::uint16_t _expected {0}; // Sequence number of the next packet to play
+    std::size_t _buffered {0};
+
+    bool _has_transit {false};
+    std::uint32_t _last_transit {0};
+
+    jitter_buffer_stats _stats;
+
+public:
+    MULTIMEDIA__EXPORT jitter_buffer (jitter_buffer_options const & opts);
+
+    // Inserts packet (without RTP header: payload only), `arrival_usec` is
+    // the local receive time used for jitter estimation.
+    MULTIMEDIA__EXPORT void push (header const & h
+        , std::uint8_t const * payload
+        , std::size_t size
+        , std::int64_t arrival_usec);
+
+    // Parses and inserts raw RTP packet. Returns false for malformed packet.
+    MULTIMEDIA__EXPORT bool push (packet_buffer const & packet, std::int64_t arrival_usec);
+
+    // Takes the next packet in sequence order. On `playout_status::ok`
+    // payload is copied into `out`.
+    MULTIMEDIA__EXPORT playout_status pop (packet_buffer & out);
+
+    // Current target latency in packets.
+    MULTIMEDIA__EXPORT std::size_t target_packets () const;
+
+    std::size_t buffered () const noexcept
+    {
+        return _buffered;
+    }
+
+    jitter_buffer_stats const & stats () const noexcept
+    {
+        return _stats;
+    }
+
+    MULTIMEDIA__EXPORT void reset ();
+};
+
+// Packet loss concealment for L16 streams. `history` holds samples of the
+// last played packet (`count` elements), they are attenuated in place and
+// must be played instead of the lost packet. Consecutive losses fade out
+// to silence. Opus streams are concealed by the decoder itself.
+MULTIMEDIA__EXPORT void conceal_l16 (std::int16_t * history
+    , std::size_t count
+    , float attenuation = 0.5f);
+
+#ifndef _WIN32
+// UDP socket with batched send/receive (`sendmmsg()`/`recvmmsg()` on Linux,
+// one system call per packet on other POSIX systems). IPv4 only.
+class udp_socket final
+{
+    using native_handle_type = int;
+
+    native_handle_type _fd {-1};
+    error_code _error;             // Socket creation error
+    std::uint64_t _truncated {0};
+
+private:
+    bool check_valid (error_code & ec) const;
+
+public:
+    // Check `valid()` (or `error()`) after construction: operations of the
+    // socket which failed to be created fail with the creation error.
+    MULTIMEDIA__EXPORT udp_socket ();
+    MULTIMEDIA__EXPORT ~udp_socket ();
+
+    udp_socket (udp_socket const &) = delete;
+    udp_socket & operator = (udp_socket const &) = delete;
+
+    // Bind to local address (empty address means any) and port.
+    MULTIMEDIA__EXPORT bool bind (std::string const & addr, std::uint16_t port, error_code & ec);
+
+    // Set default destination.
+    MULTIMEDIA__EXPORT bool connect (std::string const & addr, std::uint16_t port, error_code & ec);
+
+    // Sends `count` packets to the connected peer. Returns number of packets
+    // sent or -1 on error.
+    MULTIMEDIA__EXPORT int send (packet_buffer const * packets, std::size_t count, error_code & ec);
+
+    // Receives up to `count` packets waiting at most `timeout_ms` for the
+    // first one (negative value means infinite). Returns number of packets
+    // received (0 on timeout) or -1 on error. Datagrams larger than
+    // `PACKET_SIZE_MAX` are dropped and counted by `truncated()`.
+    MULTIMEDIA__EXPORT int receive (packet_buffer * packets
+        , std::size_t count
+        , int timeout_ms
+        , error_code & ec);
+
+    MULTIMEDIA__EXPORT void close ();
+
+    bool valid () const noexcept
+    {
+        return _fd >= 0;
+    }
+
+    error_code const & error () const noexcept
+    {
+        return _error;
+    }
+
+    // Number of dropped truncated datagrams.
+    std::uint64_t truncated () const noexcept
+    {
+        return _truncated;
+    }
+
+    native_handle_type native_handle () const noexcept
+    {
+        return _fd;
+    }
+};
+#endif // !_WIN32
+
+}} // namespace multimedia::rtp
@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Added `reclaim_readers()`.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "error.hpp"
+#include "exports.hpp"
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__linux__)
+
+namespace multimedia {
+namespace audio {
+
+// Maximum number of simultaneously attached readers.
+constexpr std::size_t SHARED_RING_READERS_MAX = 32;
+
+struct shared_ring_info
+{
+    int channels {0};
+    int sample_rate {0};
+    std::size_t frame_bytes {0};     // Bytes per frame (all channels)
+    std::size_t capacity_frames {0}; // Ring capacity, power of two
+};
+
+struct shared_ring_header;
+
+// Publisher side of the memfd-backed single-writer / multi-reader ring.
+// Captured audio is written once and mapped by subscribers in other
+// processes. The writer never waits for readers: slow readers detect
+// overwritten data themselves. Memory file descriptor is passed to
+// subscribers over a UNIX socket (SCM_RIGHTS) or opened by them through
+// `/proc/<pid>/fd/<fd>` (see `shared_ring_reader::open()`).
+class shared_ring_writer final
+{
+    int _fd {-1};
+    std::size_t _size {0};
+    shared_ring_header * _header {nullptr};
+    std::uint8_t * _data {nullptr};
+
+public:
+    shared_ring_writer () = default;
+    MULTIMEDIA__EXPORT ~shared_ring_writer ();
+
+    shared_ring_writer (shared_ring_writer const &) = delete;
+    shared_ring_writer & operator = (shared_ring_writer const &) = delete;
+
+    // Creates memory file `name` (for diagnostics only) holding the ring
+    // of at least `capacity_frames` frames.
+    MULTIMEDIA__EXPORT bool create (std::string const & name
+        , int channels
+        , int sample_rate
+        , std::size_t frame_bytes
+        , std::size_t capacity_frames
+        , error_code & ec);
+
+    // Appends frames overwriting the oldest ones. Never blocks.
+    MULTIMEDIA__EXPORT void write (void const * frames, std::size_t count);
+
+    // Total number of frames written.
+    MULTIMEDIA__EXPORT std::uint64_t position () const;
+
+    // Number of attached readers.
+    MULTIMEDIA__EXPORT std::size_t readers () const;
+
+    // Frees slots of readers whose processes terminated without detaching
+    // (crashed or killed). Readers must run in the same PID namespace as
+    // the caller. Returns number of reclaimed slots. Attaching reader does
+    // the same when there is no free slot.
+    MULTIMEDIA__EXPORT std::size_t reclaim_readers ();
+
+    // Number of attached readers that are behind the writer by more than
+    // `threshold_frames` frames.
+    MULTIMEDIA__EXPORT std::size_t lagging_readers (std::size_t threshold_frames) const;
+
+    MULTIMEDIA__EXPORT shared_ring_info info () const;
+
+    MULTIMEDIA__EXPORT void close ();
+
+    int native_handle () const noexcept
+    {
+        return _fd;
+    }
+};
+
+// Subscriber side of the shared ring. Each reader has its own cursor
+// published in the ring header, so the writer can report lagging readers.
+class shared_ring_reader final
+{
+    int _fd {-1};
+    std::size_t _size {0};
+    shared_ring_header * _header {nullptr};
+    std::uint8_t const * _data {nullptr};
+    int _slot {-1};
+    std::uint64_t _cursor {0};
+    std::uint64_t _lost_frames {0};
+    std::uint64_t _overruns {0};
+
+private:
+    bool attach (int fd, error_code & ec);
+
+public:
+    shared_ring_reader () = default;
+    MULTIMEDIA__EXPORT ~shared_ring_reader ();
+
+    shared_ring_reader (shared_ring_reader const &) = delete;
+    shared_ring_reader & operator = (shared_ring_reader const &) = delete;
+
+    // Attaches to the ring by file descriptor received from the publisher
+    // (descriptor is duplicated, caller keeps ownership of `fd`).
+    MULTIMEDIA__EXPORT bool open (int fd, error_code & ec);
+
+    // Attaches to the ring by publisher process identifier and its
+    // descriptor number (through `/proc/<pid>/fd/<fd>`).
+    MULTIMEDIA__EXPORT bool open (int pid, int fd, error_code & ec);
+
+    // Reads up to `max_frames` frames available since the last call. If
+    // the reader fell behind more than ring capacity, it skips to the oldest
+    // valid data, skipped frames are accounted in `lost_frames()`.
+    // Never blocks, returns number of frames read.
+    MULTIMEDIA__EXPORT std::size_t read (void * frames, std::size_t max_frames);
+
+    // Number of frames available for reading.
+    MULTIMEDIA__EXPORT std::size_t available () const;
+
+    MULTIMEDIA__EXPORT shared_ring_info info () const;
+
+    MULTIMEDIA__EXPORT void close ();
+
+    std::uint64_t lost_frames () const noexcept
+    {
+        return _lost_frames;
+    }
+
+    std::uint64_t overruns () const noexcept
+    {
+        return _overruns;
+    }
+};
+
+}} // namespace multimedia::audio
+
+#endif // __linux__
@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "exports.hpp"
+#include <functional>
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+namespace multimedia {
+namespace audio {
+
+class fft_plan;
+
+enum class window_type
+{
+      rectangular
+    , hann
+    , blackman_harris
+};
+
+struct spectrum_options
+{
+    // FFT size, must be a power of two (rounded up otherwise), minimum is 4.
+    std::size_t fft_size {1024};
+
+    // Distance in samples between starts of consecutive frames,
+    // `fft_size / 2` gives 50% overlap. Clamped to [1, fft_size].
+    std::size_t hop_size {512};
+
+    window_type window {window_type::hann};
+
+    // Output magnitudes in dBFS instead of linear amplitude.
+    bool decibels {false};
+};
+
+// Real input spectrum analyzer. Splits input into overlapped windowed frames
+// and calculates magnitude of `fft_size / 2 + 1` bins for each of them. All
+// buffers are allocated at construction, no allocation happens per frame.
+// FFT plans (twiddles, bit reversal tables) are shared between analyzers of
+// the same size. Instance is not thread-safe, use one instance per channel.
+class spectrum_analyzer final
+{
+public:
+    // Magnitude bins, bins count.
+    using sink_type = std::function<void (float const *, std::size_t)>;
+
+private:
+    spectrum_options _opts;
+    sink_type _sink;
+    std::shared_ptr<fft_plan const> _plan;
+
+    std::vector<float> _window;
+    float _scale {1.f};
+
+    std::vector<float> _input;     // Overlapped input frame
+    std::size_t _input_fill {0};
+
+    std::vector<float> _re;        // FFT work buffers (split complex format)
+    std::vector<float> _im;
+    std::vector<float> _magnitudes;
+
+public:
+    MULTIMEDIA__EXPORT spectrum_analyzer (spectrum_options const & opts, sink_type sink = sink_type{});
+    MULTIMEDIA__EXPORT ~spectrum_analyzer ();
+
+    // Feed samples. `stride` is the distance between consecutive samples,
+    // i.e. channels count when analyzing single channel of interleaved data.
+    // Sink is called for every completed frame.
+    MULTIMEDIA__EXPORT void process (float const * samples
+        , std::size_t count
+        , std::size_t stride = 1);
+
+    // Calculate spectrum of a single frame of `fft_size` samples. Result is
+    // available through `magnitudes()`.
+    MULTIMEDIA__EXPORT float const * analyze (float const * frame);
+
+    // Drop accumulated samples.
+    MULTIMEDIA__EXPORT void reset ();
+
+    float const * magnitudes () const noexcept
+    {
+        return _magnitudes.data();
+    }
+
+    std::size_t bins_count () const noexcept
+    {
+        return _magnitudes.size();
+    }
+
+    spectrum_options const & options () const noexcept
+    {
+        return _opts;
+    }
+};
+
+}} // namespace multimedia::audio
@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Added spectral flux onset gate.
+//      2026.10.19 Block is windowed before zero padding.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "exports.hpp"
+#include "spectrum_analyzer.hpp"
+#include <functional>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace multimedia {
+namespace audio {
+
+struct vad_options
+{
+    // Number of interleaved channels in the stream.
+    int channels {1};
+
+    // Analysis block length in frames (480 frames is 10 ms at 48 kHz).
+    std::size_t block_frames {480};
+
+    // Block is voiced when energy of any channel exceeds the tracked noise
+    // floor of this channel by this value (dB).
+    float threshold_db {9.f};
+
+    // Blocks with energy below this level (dBFS) are always silent.
+    float silence_floor_dbfs {-70.f};
+
+    // Speech onset requires normalized spectral flux of the block (positive
+    // magnitude change relative to the previous block divided by the block
+    // magnitude sum, range [0, 1]) of the channels mix to exceed this value.
+    // Stationary noise slowly rising above the tracked floor (fan, hum) has
+    // low flux and does not start an utterance. Value <= 0 disables the
+    // spectral analysis (energy only detection).
+    float flux_threshold {0.5f};
+
+    // Number of blocks the detector stays voiced after the last voiced block.
+    int hangover_blocks {30};
+
+    // Number of silent blocks preceding speech onset delivered together
+    // with it (so that the soft beginning of a word is not lost).
+    // Used only when `drop_silence` is set.
+    int preroll_blocks {10};
+
+    // Drop silent blocks instead of delivering them marked as silent.
+    bool drop_silence {true};
+};
+
+struct vad_stats
+{
+    std::uint64_t blocks_total {0};
+    std::uint64_t blocks_voiced {0};  // Including flushed pre-roll blocks
+    std::uint64_t blocks_dropped {0}; // Excluding flushed pre-roll blocks
+};
+
+// Energy/spectral flux voice activity detector with hangover and pre-roll
+// buffering.
+// Accepts interleaved samples of arbitrary length, splits them into analysis
+// blocks and delivers blocks to the sink marked as voiced/silent (or drops
+// silent blocks). Instance is not thread-safe, use one instance per stream.
+class voice_activity_detector final
+{
+public:
+    // Interleaved samples, number of frames, voiced flag.
+    using sink_type = std::function<void (float const *, std::size_t, bool)>;
+
+private:
+    vad_options _opts;
+    sink_type _sink;
+    vad_stats _stats;
+
+    std::vector<float> _block;       // Accumulated block
+    std::size_t _block_fill {0};     // Number of frames in `_block`
+
+    std::vector<float> _preroll;     // Ring of `preroll_blocks` blocks
+    std::size_t _preroll_head {0};
+    std::size_t _preroll_count {0};
+
+    std::vector<float> _energy;      // Per-channel energy of current block
+    std::vector<float> _noise_floor; // Per-channel tracked noise floor
+    bool _noise_floor_initialized {false};
+
+    std::unique_ptr<spectrum_analyzer> _spectrum; // `nullptr` if flux is disabled
+    std::vector<float> _prev_block;  // Last silent block
+    bool _prev_block_valid {false};
+    std::vector<float> _window;      // Hann window of the block length
+    std::vector<float> _mix;         // Zero padded windowed channels mix of the block
+    std::vector<float> _prev_magnitudes;
+    float _flux {0};
+
+    int _hangover {0};
+
+private:
+    void process_block ();
+    bool detect ();
+    void mix (float const * block);
+    float spectral_flux ();
+    void deliver (float const * samples, bool voiced);
+
+public:
+    MULTIMEDIA__EXPORT voice_activity_detector (vad_options const & opts, sink_type sink);
+    MULTIMEDIA__EXPORT ~voice_activity_detector ();
+
+    // Process interleaved float samples in range [-1.0, 1.0].
+    MULTIMEDIA__EXPORT void process (float const * samples, std::size_t frames);
+
+    // Process interleaved signed 16-bit samples.
+    MULTIMEDIA__EXPORT void process (std::int16_t const * samples, std::size_t frames);
+
+    // Drop buffered pre-roll and incomplete block, reset detector state.
+    MULTIMEDIA__EXPORT void reset ();
+
+    bool voiced () const noexcept
+    {
+        return _hangover > 0;
+    }
+
+    // Spectral flux of the last onset candidate block (0 if disabled).
+    float flux () const noexcept
+    {
+        return _flux;
+    }
+
+    vad_stats const & stats () const noexcept
+    {
+        return _stats;
+    }
+
+    vad_options const & options () const noexcept
+    {
+        return _opts;
+    }
+};
+
+// Sum of squares of every channel of interleaved samples divided by number
+// of frames (mean energy). Result written to `energy` (`channels` elements).
+MULTIMEDIA__EXPORT void channel_energy (float const * samples
+    , std::size_t frames
+    , int channels
+    , float * energy);
+
+}} // namespace multimedia::audio
@@ -0,0 +1,173 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Intrusive reference counting of frame buffers.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "exports.hpp"
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+namespace multimedia {
+namespace video {
+
+enum class pixel_format
+{
+      i420  // Planar Y, U, V; chroma subsampled 2x2
+    , nv12  // Planar Y, interleaved UV; chroma subsampled 2x2
+    , yuyv  // Packed Y0 U Y1 V; chroma subsampled 2x1
+    , rgb24 // Packed R G B
+    , rgba  // Packed R G B A
+};
+
+// YCbCr matrix, limited (studio) range.
+enum class color_space
+{
+      bt601
+    , bt709
+};
+
+// Default alignment of plane rows (fits widest SIMD registers).
+constexpr std::size_t FRAME_ALIGNMENT = 64;
+
+struct frame_buffer;
+
+// Video frame with up to three planes stored in one aligned buffer. Frame
+// is a cheap handle: copies share the buffer (reference counter is stored
+// in the buffer itself, so handles never allocate). Buffers acquired from
+// the `frame_pool` return to the pool when the last handle is destroyed.
+class frame final
+{
+    friend class frame_pool;
+
+    pixel_format _format {pixel_format::i420};
+    int _width {0};
+    int _height {0};
+    int _planes_count {0};
+    std::uint8_t * _data[3] {nullptr, nullptr, nullptr};
+    std::size_t _stride[3] {0, 0, 0};
+    frame_buffer * _buffer {nullptr};
+
+private:
+    // Takes ownership of the `buffer` reference.
+    void assign (frame_buffer * buffer
+        , pixel_format format
+        , int width
+        , int height
+        , std::size_t alignment);
+
+public:
+    frame () = default;
+    MULTIMEDIA__EXPORT frame (frame const & other);
+    MULTIMEDIA__EXPORT frame (frame && other) noexcept;
+    MULTIMEDIA__EXPORT frame & operator = (frame const & other);
+    MULTIMEDIA__EXPORT frame & operator = (frame && other) noexcept;
+    MULTIMEDIA__EXPORT ~frame ();
+
+    // Allocates standalone (not pooled) frame.
+    static MULTIMEDIA__EXPORT frame allocate (pixel_format format
+        , int width
+        , int height
+        , std::size_t alignment = FRAME_ALIGNMENT);
+
+    // Size of the buffer required for frame with specified parameters.
+    static MULTIMEDIA__EXPORT std::size_t buffer_size (pixel_format format
+        , int width
+        , int height
+        , std::size_t alignment = FRAME_ALIGNMENT);
+
+    static MULTIMEDIA__EXPORT int planes_count (pixel_format format);
+
+    bool empty () const noexcept
+    {
+        return _buffer == nullptr;
+    }
+
+    pixel_format format () const noexcept
+    {
+        return _format;
+    }
+
+    int width () const noexcept
+    {
+        return _width;
+    }
+
+    int height () const noexcept
+    {
+        return _height;
+    }
+
+    int planes_count () const noexcept
+    {
+        return _planes_count;
+    }
+
+    std::uint8_t * data (int plane) noexcept
+    {
+        return _data[plane];
+    }
+
+    std::uint8_t const * data (int plane) const noexcept
+    {
+        return _data[plane];
+    }
+
+    std::size_t stride (int plane) const noexcept
+    {
+        return _stride[plane];
+    }
+
+    // Number of meaningful bytes in a row of the plane (without padding).
+    MULTIMEDIA__EXPORT std::size_t plane_row_bytes (int plane) const;
+
+    // Number of rows in the plane.
+    MULTIMEDIA__EXPORT int plane_height (int plane) const;
+};
+
+// Pool of frame buffers of the same format and size. Acquiring a frame
+// allocates only when the pool has no free buffer. Thread-safe. Frames may
+// outlive the pool.
+class frame_pool final
+{
+    friend struct frame_buffer;
+
+    struct impl;
+    std::shared_ptr<impl> _d;
+
+public:
+    // `max_free` is the maximum number of idle buffers kept in the pool.
+    MULTIMEDIA__EXPORT frame_pool (pixel_format format
+        , int width
+        , int height
+        , std::size_t max_free = 16
+        , std::size_t alignment = FRAME_ALIGNMENT);
+
+    MULTIMEDIA__EXPORT ~frame_pool ();
+
+    MULTIMEDIA__EXPORT frame acquire ();
+
+    // Number of idle buffers.
+    MULTIMEDIA__EXPORT std::size_t free_count () const;
+
+    MULTIMEDIA__EXPORT pixel_format format () const;
+    MULTIMEDIA__EXPORT int width () const;
+    MULTIMEDIA__EXPORT int height () const;
+};
+
+// Converts `src` into `dst` of the same size (any pair of supported
+// formats). Large frames are split into row bands processed in parallel,
+// `threads` limits their number (0 means choose automatically, 1 disables
+// parallel processing). Returns false if frames are empty or their sizes
+// differ.
+MULTIMEDIA__EXPORT bool convert (frame const & src
+    , frame & dst
+    , color_space cs = color_space::bt601
+    , std::size_t threads = 0);
+
+}} // namespace multimedia::video
@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "error.hpp"
+#include "exports.hpp"
+#include "video.hpp"
+#include <functional>
+#include <memory>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+#if MULTIMEDIA__FFMPEG_ENABLED
+
+namespace multimedia {
+namespace video {
+
+struct encoder_options
+{
+    int width {0};
+    int height {0};
+    int frame_rate {30};
+
+    // Target bitrate in bits per second, 0 means constant quality (`crf`).
+    std::int64_t bitrate {0};
+    int crf {23};
+
+    // x264 preset (ultrafast, superfast, veryfast, faster, fast, medium,
+    // slow, slower, veryslow) and optional tune (e.g. zerolatency).
+    std::string preset {"veryfast"};
+    std::string tune;
+
+    int gop_size {60};
+    int max_b_frames {2};
+
+    // Encoder threads, 0 means choose automatically.
+    int threads {0};
+
+    // Matrix used when submitted frames are RGB.
+    color_space cs {color_space::bt601};
+
+    // Capacity of the queues between stages.
+    std::size_t queue_size {8};
+};
+
+// Encoded H.264 access unit (Annex B byte stream when encoding to callback).
+// Timestamps are in units of 1 / `frame_rate`.
+struct packet
+{
+    std::uint8_t const * data {nullptr};
+    std::size_t size {0};
+    std::int64_t pts {0};
+    std::int64_t dts {0};
+    bool keyframe {false};
+};
+
+using packet_callback = std::function<void (packet const &)>;
+
+// H.264 encoder (libx264 via libavcodec) of frames generated in memory.
+// Pixel format conversion, encoding and muxing (or delivery to callback)
+// run as pipeline stages on separate threads connected by bounded queues,
+// so `submit()` returns as soon as the frame is queued. I420 frames are
+// passed to the encoder without copying: the frame buffer is referenced
+// until the encoder releases it, so frames from `frame_pool` are recycled
+// only then.
+class encoder final
+{
+    class impl;
+    std::unique_ptr<impl> _d;
+
+public:
+    MULTIMEDIA__EXPORT encoder ();
+    MULTIMEDIA__EXPORT ~encoder ();
+
+    encoder (encoder const &) = delete;
+    encoder & operator = (encoder const &) = delete;
+
+    // Starts encoding into media file, container is chosen by file
+    // extension (e.g. mp4, mkv).
+    MULTIMEDIA__EXPORT bool open (std::string const & path
+        , encoder_options const & opts
+        , error_code & ec);
+
+    // Starts encoding into raw H.264 stream delivered to `callback` (called
+    // from the muxing stage thread).
+    MULTIMEDIA__EXPORT bool open (packet_callback callback
+        , encoder_options const & opts
+        , error_code & ec);
+
+    // Queues frame of any supported format with size specified in options.
+    // Blocks while the pipeline queues are full. `pts` is in units of
+    // 1 / `frame_rate`, negative value means next after the previous frame.
+    // Returns false if the encoder is not open, frame size mismatches or
+    // pipeline failed (see `finish()`).
+    MULTIMEDIA__EXPORT bool submit (frame const & f, std::int64_t pts = -1);
+
+    // Flushes the encoder, finalizes the output and stops the pipeline
+    // (no more frames can be submitted until next `open()`). Returns false
+    // and sets `ec` if any stage failed.
+    MULTIMEDIA__EXPORT bool finish (error_code & ec);
+
+    // Number of encoded packets passed to output.
+    MULTIMEDIA__EXPORT std::size_t packets_count () const;
+};
+
+}} // namespace multimedia::video
+
+#endif // MULTIMEDIA__FFMPEG_ENABLED
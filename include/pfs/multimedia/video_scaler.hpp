@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Pyramid levels are scaled from the source by default.
+//      2026.10.19 Single pass pyramid mode (default).
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "exports.hpp"
+#include "video.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace multimedia {
+namespace video {
+
+enum class scale_filter
+{
+      bilinear
+    , bicubic  // Catmull-Rom spline
+    , lanczos  // Lanczos with three lobes
+};
+
+// How levels of a multi-size output are produced.
+enum class pyramid_mode
+{
+      single_pass // All levels are scaled from the source read once
+    , direct      // Every level is scaled from the source separately
+    , cascade     // Every level is scaled from the previous (larger) level
+};
+
+// Input rows read by a multi-size scaling: number of bytes of distinct rows
+// read by each row band (rows re-read by other bands are counted again).
+struct pyramid_traffic
+{
+    std::uint64_t source_bytes {0};
+    std::uint64_t level_bytes {0};  // Already produced levels (`cascade`)
+};
+
+// Separable frame scaler. Filter coefficient tables for each pair of source
+// and destination dimensions are calculated once and shared by all scalers
+// (thread-safe). Destination rows are split into bands processed in parallel.
+//
+// Supported formats are planar and packed RGB ones: `i420`, `nv12`, `rgb24`
+// and `rgba` (`yuyv` must be converted first).
+class scaler final
+{
+    scale_filter _filter;
+    std::size_t _threads;
+
+public:
+    // `threads` limits number of row bands processed in parallel (0 means
+    // number of hardware threads, 1 disables parallel processing).
+    scaler (scale_filter filter = scale_filter::bilinear, std::size_t threads = 0)
+        : _filter(filter)
+        , _threads(threads)
+    {}
+
+    scale_filter filter () const noexcept
+    {
+        return _filter;
+    }
+
+    // Scales `src` into `dst` (sizes are taken from frames). Returns false if
+    // frames are empty, formats differ or format is not supported.
+    MULTIMEDIA__EXPORT bool scale (frame const & src, frame & dst) const;
+
+    // Produces several output sizes (pyramid) from one source. In
+    // `single_pass` and `direct` modes the result is the same as of scaling
+    // every output separately. `single_pass` walks bands of source rows once
+    // and feeds the vertical filters of all outputs from each row, while
+    // `direct` reads the whole source once per output.
+    // In `cascade` mode outputs are scaled in descending order of size, each
+    // from the smallest already produced frame not smaller than it: smaller
+    // levels are cheaper to compute (filters span fewer source samples), but
+    // they are filtered several times, so blur and rounding errors of all
+    // previous levels accumulate.
+    MULTIMEDIA__EXPORT bool scale (frame const & src
+        , frame * dsts
+        , std::size_t count
+        , pyramid_mode mode = pyramid_mode::single_pass) const;
+
+    // Input rows read by `scale()` of a pyramid with the same arguments.
+    MULTIMEDIA__EXPORT pyramid_traffic traffic (frame const & src
+        , frame const * dsts
+        , std::size_t count
+        , pyramid_mode mode = pyramid_mode::single_pass) const;
+};
+
+}} // namespace multimedia::video
@@ -6,12 +6,19 @@
 # Changelog:
 #      2021.08.03 Initial version.
 #      2022.01.20 Refactored for use `portable_target`.
+#      2026.10.19 Added platform independent audio processing sources.
+#      2026.10.19 Added optional FFmpeg backend.
+#      2026.10.19 Added aggregate input.
+#      2026.10.19 Added optional Opus and FLAC encoders.
 ################################################################################
 cmake_minimum_required (VERSION 3.11)
 project(multimedia CXX)
 
 option(MULTIMEDIA__ENABLE_PULSEAUDIO "Enable PulseAudio as backend" ON)
 option(MULTIMEDIA__ENABLE_QT5 "Enable Qt5 Multimedia as backend" OFF)
+option(MULTIMEDIA__ENABLE_FFMPEG "Enable FFmpeg based media decoding/encoding" OFF)
+option(MULTIMEDIA__ENABLE_OPUS "Enable Opus audio encoder (libopus)" OFF)
+option(MULTIMEDIA__ENABLE_FLAC "Enable FLAC audio encoder (libFLAC)" OFF)
 set(_audio_backend_FOUND OFF)
 
 portable_target(ADD_SHARED ${PROJECT_NAME} ALIAS pfs::multimedia 
@@ -21,6 +28,83 @@ portable_target(ADD_SHARED ${PROJECT_NAME} ALIAS pfs::multimedia
     STATIC_EXPORTS MULTIMEDIA__STATIC)
 portable_target(INCLUDE_DIRS ${PROJECT_NAME} PUBLIC ${CMAKE_CURRENT_LIST_DIR}/include)
 
+# Platform independent sources
+portable_target(SOURCES ${PROJECT_NAME}
+    ${CMAKE_CURRENT_LIST_DIR}/src/aggregate_input.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/drift_compensator.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/encoder_pipeline.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/parallel_for.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/resampler.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/rtp.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/spectrum_analyzer.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/vad.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/video_convert.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/video_frame.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/src/video_scaler.cpp)
+
+if (NOT ${CMAKE_SYSTEM_NAME} STREQUAL "Windows")
+    portable_target(SOURCES ${PROJECT_NAME}
+        ${CMAKE_CURRENT_LIST_DIR}/src/rtp_socket_posix.cpp)
+endif()
+
+if (${CMAKE_SYSTEM_NAME} STREQUAL "Linux")
+    portable_target(SOURCES ${PROJECT_NAME}
+        ${CMAKE_CURRENT_LIST_DIR}/src/shared_ring_linux.cpp)
+endif()
+
+if (MULTIMEDIA__ENABLE_FFMPEG)
+    # In Ubuntu it is a part of 'libavformat-dev' and 'libavcodec-dev' packages
+    find_package(PkgConfig REQUIRED)
+    pkg_check_modules(FFMPEG REQUIRED libavformat libavcodec libavutil)
+
+    message(STATUS "FFmpeg libavcodec version: ${FFMPEG_libavcodec_VERSION}")
+
+    portable_target(SOURCES ${PROJECT_NAME}
+        ${CMAKE_CURRENT_LIST_DIR}/src/decode_pipeline_ffmpeg.cpp
+        ${CMAKE_CURRENT_LIST_DIR}/src/video_encoder_ffmpeg.cpp)
+    portable_target(INCLUDE_DIRS ${PROJECT_NAME} PRIVATE ${FFMPEG_INCLUDE_DIRS})
+
+    portable_target(LINK ${PROJECT_NAME} PRIVATE ${FFMPEG_LINK_LIBRARIES})
+    portable_target(LINK ${PROJECT_NAME}-static PRIVATE ${FFMPEG_LINK_LIBRARIES})
+
+    portable_target(DEFINITIONS ${PROJECT_NAME} PUBLIC "MULTIMEDIA__FFMPEG_ENABLED=1")
+    portable_target(DEFINITIONS ${PROJECT_NAME}-static PUBLIC "MULTIMEDIA__FFMPEG_ENABLED=1")
+endif(MULTIMEDIA__ENABLE_FFMPEG)
+
+if (MULTIMEDIA__ENABLE_OPUS)
+    # In Ubuntu it is a part of 'libopus-dev' package
+    find_package(PkgConfig REQUIRED)
+    pkg_check_modules(OPUS REQUIRED opus)
+
+    message(STATUS "Opus version: ${OPUS_VERSION}")
+
+    portable_target(SOURCES ${PROJECT_NAME} ${CMAKE_CURRENT_LIST_DIR}/src/encoder_opus.cpp)
+    portable_target(INCLUDE_DIRS ${PROJECT_NAME} PRIVATE ${OPUS_INCLUDE_DIRS})
+
+    portable_target(LINK ${PROJECT_NAME} PRIVATE ${OPUS_LINK_LIBRARIES})
+    portable_target(LINK ${PROJECT_NAME}-static PRIVATE ${OPUS_LINK_LIBRARIES})
+
+    portable_target(DEFINITIONS ${PROJECT_NAME} PUBLIC "MULTIMEDIA__OPUS_ENABLED=1")
+    portable_target(DEFINITIONS ${PROJECT_NAME}-static PUBLIC "MULTIMEDIA__OPUS_ENABLED=1")
+endif(MULTIMEDIA__ENABLE_OPUS)
+
+if (MULTIMEDIA__ENABLE_FLAC)
+    # In Ubuntu it is a part of 'libflac-dev' package
+    find_package(PkgConfig REQUIRED)
+    pkg_check_modules(FLAC REQUIRED flac)
+
+    message(STATUS "FLAC version: ${FLAC_VERSION}")
+
+    portable_target(SOURCES ${PROJECT_NAME} ${CMAKE_CURRENT_LIST_DIR}/src/encoder_flac.cpp)
+    portable_target(INCLUDE_DIRS ${PROJECT_NAME} PRIVATE ${FLAC_INCLUDE_DIRS})
+
+    portable_target(LINK ${PROJECT_NAME} PRIVATE ${FLAC_LINK_LIBRARIES})
+    portable_target(LINK ${PROJECT_NAME}-static PRIVATE ${FLAC_LINK_LIBRARIES})
+
+    portable_target(DEFINITIONS ${PROJECT_NAME} PUBLIC "MULTIMEDIA__FLAC_ENABLED=1")
+    portable_target(DEFINITIONS ${PROJECT_NAME}-static PUBLIC "MULTIMEDIA__FLAC_ENABLED=1")
+endif(MULTIMEDIA__ENABLE_FLAC)
+
 if (MULTIMEDIA__ENABLE_QT5)
     #find_package(Qt5 COMPONENTS Core Multimedia REQUIRED)
 
@@ -0,0 +1,396 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Frames lost on input ring overrun are replaced by silence.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/multimedia/aggregate_input.hpp"
+#include "pfs/multimedia/drift_compensator.hpp"
+#include "spsc_ring.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace multimedia {
+namespace audio {
+
+static constexpr std::size_t CLOCK_RING_CAPACITY = 256;
+
+struct device_lane
+{
+    aggregate_device dev;
+    std::size_t channels;
+
+    // Producer (device capture thread) side
+    spsc_ring<float> samples;
+    spsc_ring<clock_sample> clock;
+    std::uint64_t frames_written {0};
+
+    // Consumer (master capture thread) side. Positions are measured in
+    // frames of the device stream (raw frames).
+    std::unique_ptr<drift_compensator> compensator; // `nullptr` for master
+    std::vector<float> raw;         // Scratch buffer for frames read from the ring
+    std::vector<float> pending;     // Resampled frames not emitted yet
+    double produced_pos {0};        // Position of the next resampler output in fed stream
+    std::uint64_t dropped {0};      // Frames dropped before resampling
+    std::uint64_t lost {0};         // Frames lost on input ring overrun (accounted)
+    std::size_t drop_remaining {0}; // Frames to drop to restore alignment
+    std::size_t zeros_pending {0};  // Silence frames to emit to restore alignment
+    bool has_clock {false};
+    bool aligned {false};
+
+    std::atomic<double> drift_ppm {0};
+    std::atomic<double> ratio {1.0};
+    std::atomic<double> alignment_error {0};
+    std::atomic<std::uint64_t> overrun_frames {0};
+    std::atomic<std::uint64_t> underrun_frames {0};
+    std::atomic<std::uint64_t> realignments {0};
+
+    device_lane (aggregate_device const & d, aggregate_options const & opts, bool master)
+        : dev(d)
+        , channels(static_cast<std::size_t>(d.channels < 1 ? 1 : d.channels))
+        , samples(master ? 0 : opts.input_ring_frames * channels)
+        , clock(master ? 0 : CLOCK_RING_CAPACITY)
+    {
+        dev.channels = static_cast<int>(channels);
+
+        if (master) {
+            pending.reserve((opts.latency_frames + opts.max_frames) * channels);
+            return;
+        }
+
+        drift_options dopts;
+        dopts.channels = dev.channels;
+        dopts.sample_rate = opts.sample_rate;
+        dopts.target_latency_frames = opts.realign_threshold_frames;
+        dopts.max_correction_ppm = opts.max_correction_ppm;
+        dopts.kp = opts.kp;
+        dopts.ki = opts.ki;
+        dopts.window = opts.window;
+
+        compensator.reset(new drift_compensator{dopts});
+        raw.resize(opts.max_frames * channels);
+
+        // Input ring content plus resampler margin
+        pending.reserve((opts.input_ring_frames + opts.max_frames) * channels * 2);
+    }
+
+    std::size_t pending_frames () const noexcept
+    {
+        return pending.size() / channels;
+    }
+
+    // Drops frames requested by realignment: older resampled frames first.
+    void apply_drop ()
+    {
+        if (drop_remaining == 0)
+            return;
+
+        auto n = std::min(drop_remaining, pending_frames());
+        pending.erase(pending.begin(), pending.begin() + n * channels);
+        drop_remaining -= n;
+
+        n = samples.pop(nullptr, drop_remaining * channels) / channels;
+        dropped += n;
+        drop_remaining -= n;
+    }
+
+    // Replaces frames lost on input ring overrun by silence. Silence is
+    // emitted right away, i.e. before the frames preceding the gap that
+    // are still queued, but the position of the frames following the gap
+    // is exact, so the alignment is not disturbed.
+    void account_lost ()
+    {
+        auto n = overrun_frames.load(std::memory_order_relaxed) - lost;
+
+        lost += n;
+        zeros_pending += static_cast<std::size_t>(n);
+    }
+
+    // Reads frames from the input ring and resamples them to master clock.
+    void pull ()
+    {
+        account_lost();
+        apply_drop();
+
+        auto chunk_frames = raw.size() / channels;
+
+        while (true) {
+            auto n = std::min(chunk_frames, samples.read_available() / channels);
+
+            if (n == 0)
+                break;
+
+            auto room = compensator->output_frames_max(n);
+
+            // Leave data in the input ring if there is no room (master clock
+            // stalled)
+            if ((pending_frames() + room) * channels > pending.capacity())
+                break;
+
+            samples.pop(raw.data(), n * channels);
+
+            auto offset = pending.size();
+            pending.resize(offset + room * channels);
+            auto produced = compensator->process(raw.data(), n, pending.data() + offset);
+            pending.resize(offset + produced * channels);
+
+            produced_pos += static_cast<double>(produced) / compensator->ratio();
+        }
+    }
+
+    // Position of the next emitted frame in the device stream.
+    double next_position () const
+    {
+        return static_cast<double>(dropped + lost) + produced_pos
+            - static_cast<double>(pending_frames()) / compensator->ratio()
+            + static_cast<double>(drop_remaining)
+            - static_cast<double>(zeros_pending);
+    }
+
+    // Writes `count` frames into `output` (interleaved with `stride` samples
+    // per frame).
+    void emit (float * output, std::size_t stride, std::size_t count)
+    {
+        std::size_t i = 0;
+
+        auto put_zeros = [& i, output, stride, this] (std::size_t n) {
+            for (; n > 0; n--, i++)
+                std::fill_n(output + i * stride, channels, 0.f);
+        };
+
+        auto z = std::min(zeros_pending, count);
+        put_zeros(z);
+        zeros_pending -= z;
+
+        auto n = std::min(pending_frames(), count - z);
+
+        for (std::size_t j = 0; j < n; j++, i++)
+            std::copy_n(pending.data() + j * channels, channels, output + i * stride);
+
+        pending.erase(pending.begin(), pending.begin() + n * channels);
+
+        auto rest = count - z - n;
+
+        if (rest > 0) {
+            put_zeros(rest);
+
+            // Late frames stand in for the emitted silence and must be
+            // dropped to keep the alignment
+            if (aligned) {
+                drop_remaining += rest;
+                underrun_frames.fetch_add(rest, std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+class aggregate_input::impl
+{
+public:
+    aggregate_options opts;
+    std::vector<std::unique_ptr<device_lane>> lanes;
+    std::size_t channels {0};
+    clock_drift_estimator master_clock;
+    std::vector<float> output;
+    spsc_ring<float> ring;
+
+public:
+    impl (std::vector<aggregate_device> const & devices, aggregate_options const & o)
+        : opts(o)
+        , channels(total_channels(devices))
+        , master_clock(o.sample_rate, o.window)
+        , output(o.max_frames * channels)
+        , ring(o.output_ring_frames * channels)
+    {
+        for (std::size_t i = 0; i < devices.size(); i++)
+            lanes.emplace_back(new device_lane{devices[i], opts, i == 0});
+    }
+
+    static std::size_t total_channels (std::vector<aggregate_device> const & devices)
+    {
+        std::size_t result = 0;
+
+        for (auto const & d: devices)
+            result += static_cast<std::size_t>(d.channels < 1 ? 1 : d.channels);
+
+        return result;
+    }
+
+    void align (device_lane & lane, std::int64_t time_usec)
+    {
+        if (!lane.has_clock)
+            return;
+
+        // Frame of the device stream captured at `time_usec`
+        double expected = lane.compensator->input_clock().frames_at(time_usec);
+
+        double error = expected - lane.next_position();
+        auto threshold = static_cast<double>(opts.realign_threshold_frames);
+
+        if (!lane.aligned || std::fabs(error) > threshold) {
+            if (error > 0)
+                lane.drop_remaining += static_cast<std::size_t>(std::lround(error));
+            else
+                lane.zeros_pending += static_cast<std::size_t>(std::lround(-error));
+
+            lane.aligned = true;
+            lane.realignments.fetch_add(1, std::memory_order_relaxed);
+            lane.apply_drop();
+        } else {
+            // Positive error means the device stream is behind, so it must
+            // be consumed faster (same as too many queued frames)
+            lane.compensator->update_latency(static_cast<std::size_t>(
+                std::lround(threshold + error)));
+        }
+
+        lane.alignment_error.store(error, std::memory_order_relaxed);
+        lane.ratio.store(lane.compensator->ratio(), std::memory_order_relaxed);
+        lane.drift_ppm.store(lane.compensator->input_clock().drift_ppm(), std::memory_order_relaxed);
+    }
+
+    void write_master (float const * samples, std::size_t frames, std::int64_t time_usec)
+    {
+        auto & master = *lanes[0];
+        clock_sample const master_clock_sample {time_usec, master.frames_written};
+        clock_sample cs;
+
+        master_clock.update(master_clock_sample);
+        master.frames_written += frames;
+        master.pending.insert(master.pending.end(), samples, samples + frames * master.channels);
+        master.drift_ppm.store(master_clock.drift_ppm(), std::memory_order_relaxed);
+
+        for (std::size_t i = 1; i < lanes.size(); i++) {
+            auto & lane = *lanes[i];
+
+            while (lane.clock.pop(& cs, 1) > 0) {
+                lane.compensator->update_input_clock(cs);
+                lane.has_clock = true;
+            }
+
+            lane.compensator->update_output_clock(master_clock_sample);
+            lane.pull();
+        }
+
+        auto queued = master.pending_frames();
+
+        if (queued <= opts.latency_frames)
+            return;
+
+        auto count = std::min(queued - opts.latency_frames, opts.max_frames);
+
+        // Capture time of the first frame to emit
+        auto time_emit = master_clock.time_at(static_cast<double>(master.frames_written - queued));
+
+        std::size_t offset = 0;
+
+        for (std::size_t i = 0; i < lanes.size(); i++) {
+            auto & lane = *lanes[i];
+
+            if (i == 0) {
+                for (std::size_t j = 0; j < count; j++) {
+                    std::copy_n(lane.pending.data() + j * lane.channels, lane.channels
+                        , output.data() + j * channels);
+                }
+
+                lane.pending.erase(lane.pending.begin(), lane.pending.begin() + count * lane.channels);
+            } else {
+                align(lane, time_emit);
+                lane.emit(output.data() + offset, channels, count);
+            }
+
+            offset += lane.channels;
+        }
+
+        // Reader is too slow
+        if (!ring.push(output.data(), count * channels))
+            master.overrun_frames.fetch_add(count, std::memory_order_relaxed);
+    }
+};
+
+aggregate_input::aggregate_input (std::vector<aggregate_device> const & devices
+    , aggregate_options const & opts)
+    : _d(new impl{devices, opts})
+{}
+
+aggregate_input::~aggregate_input () = default;
+
+std::size_t aggregate_input::devices_count () const
+{
+    return _d->lanes.size();
+}
+
+aggregate_device const & aggregate_input::device (std::size_t index) const
+{
+    return _d->lanes.at(index)->dev;
+}
+
+int aggregate_input::channels () const
+{
+    return static_cast<int>(_d->channels);
+}
+
+bool aggregate_input::write (std::size_t index
+    , float const * samples
+    , std::size_t frames
+    , std::int64_t time_usec)
+{
+    if (index >= _d->lanes.size() || frames > _d->opts.max_frames)
+        return false;
+
+    if (index == 0) {
+        _d->write_master(samples, frames, time_usec);
+        return true;
+    }
+
+    auto & lane = *_d->lanes[index];
+    clock_sample cs {time_usec, lane.frames_written};
+
+    // Frames index keeps counting even if the frames are lost, the consumer
+    // replaces them by silence (see `device_lane::account_lost()`)
+    lane.frames_written += frames;
+
+    // Clock sample may be skipped if the consumer lags, the estimation
+    // tolerates it
+    lane.clock.push(& cs, 1);
+
+    if (!lane.samples.push(samples, frames * lane.channels))
+        lane.overrun_frames.fetch_add(frames, std::memory_order_relaxed);
+
+    return true;
+}
+
+std::size_t aggregate_input::read (float * frames, std::size_t max_frames)
+{
+    auto nchannels = _d->channels;
+
+    if (nchannels == 0)
+        return 0;
+
+    return _d->ring.pop(frames, max_frames * nchannels) / nchannels;
+}
+
+std::size_t aggregate_input::available () const
+{
+    return _d->channels > 0 ? _d->ring.read_available() / _d->channels : 0;
+}
+
+aggregate_stats aggregate_input::stats (std::size_t index) const
+{
+    aggregate_stats result;
+    auto const & lane = *_d->lanes.at(index);
+
+    result.drift_ppm = lane.drift_ppm.load(std::memory_order_relaxed);
+    result.ratio = lane.ratio.load(std::memory_order_relaxed);
+    result.alignment_error = lane.alignment_error.load(std::memory_order_relaxed);
+    result.overrun_frames = lane.overrun_frames.load(std::memory_order_relaxed);
+    result.underrun_frames = lane.underrun_frames.load(std::memory_order_relaxed);
+    result.realignments = lane.realignments.load(std::memory_order_relaxed);
+
+    return result;
+}
+
+}} // namespace multimedia::audio
@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <cstddef>
+
+namespace multimedia {
+
+// Blocking queue of limited capacity. `abort()` wakes up and fails all
+// waiting and subsequent operations.
+template <typename T>
+class bounded_queue final
+{
+    std::mutex _mtx;
+    std::condition_variable _not_empty;
+    std::condition_variable _not_full;
+    std::deque<T> _items;
+    std::size_t _capacity;
+    bool _aborted {false};
+
+public:
+    explicit bounded_queue (std::size_t capacity)
+        : _capacity(capacity > 0 ? capacity : 1)
+    {}
+
+    bool push (T item)
+    {
+        std::unique_lock<std::mutex> locker{_mtx};
+        _not_full.wait(locker, [this] { return _aborted || _items.size() < _capacity; });
+
+        if (_aborted)
+            return false;
+
+        _items.push_back(std::move(item));
+        locker.unlock();
+        _not_empty.notify_one();
+        return true;
+    }
+
+    bool pop (T & item)
+    {
+        std::unique_lock<std::mutex> locker{_mtx};
+        _not_empty.wait(locker, [this] { return _aborted || !_items.empty(); });
+
+        if (_aborted)
+            return false;
+
+        item = std::move(_items.front());
+        _items.pop_front();
+        locker.unlock();
+        _not_full.notify_one();
+        return true;
+    }
+
+    // Removes all items passing them to `dispose`.
+    template <typename F>
+    void clear (F && dispose)
+    {
+        std::deque<T> items;
+
+        {
+            std::lock_guard<std::mutex> locker{_mtx};
+            items.swap(_items);
+        }
+
+        _not_full.notify_all();
+
+        for (auto & item: items)
+            dispose(item);
+    }
+
+    void abort ()
+    {
+        {
+            std::lock_guard<std::mutex> locker{_mtx};
+            _aborted = true;
+        }
+
+        _not_empty.notify_all();
+        _not_full.notify_all();
+    }
+};
+
+} // namespace multimedia
@@ -0,0 +1,682 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// References:
+//      1. FFmpeg libav tutorial (https://github.com/leandromoreira/ffmpeg-libav-tutorial)
+//      2. ffplay.c: packet serials used to discard data queued before seek.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Moved into `multimedia::video` namespace.
+//      2026.10.19 Pooled frame entries are reused without allocations.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/multimedia/decode_pipeline.hpp"
+#include "bounded_queue.hpp"
+#include "ffmpeg_utils.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/avutil.h>
+}
+
+namespace multimedia {
+namespace video {
+
+namespace {
+class av_frame_pool;
+} // namespace
+
+// Pooled `AVFrame` with the counter of `decoded_frame` handles referencing
+// it.
+struct decoded_frame_buffer
+{
+    AVFrame * frame {nullptr};
+    std::atomic<std::size_t> refs {1};
+
+    // Owner pool while the frame is in use (null for idle entries, so the
+    // pool does not reference itself)
+    std::shared_ptr<av_frame_pool> pool;
+
+    ~decoded_frame_buffer ()
+    {
+        av_frame_free(& frame);
+    }
+
+    static void add_ref (decoded_frame_buffer * b) noexcept
+    {
+        if (b)
+            b->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void release (decoded_frame_buffer * b) noexcept;
+};
+
+namespace {
+
+// Pool of `AVFrame` structures. Picture and sample buffers referenced by
+// the frames are reference counted and recycled by the decoders own buffer
+// pools when the frame is unreferenced.
+class av_frame_pool final : public std::enable_shared_from_this<av_frame_pool>
+{
+    std::mutex _mtx;
+    std::vector<std::unique_ptr<decoded_frame_buffer>> _free;
+
+public:
+    // Moves the data of the received frame `src` into a pooled entry.
+    // Allocates only when the pool has no free entry.
+    decoded_frame_buffer * acquire (AVFrame * src)
+    {
+        std::unique_ptr<decoded_frame_buffer> b;
+
+        {
+            std::lock_guard<std::mutex> locker{_mtx};
+
+            if (!_free.empty()) {
+                b = std::move(_free.back());
+                _free.pop_back();
+            }
+        }
+
+        if (!b) {
+            b.reset(new decoded_frame_buffer);
+            b->frame = av_frame_alloc();
+
+            if (!b->frame)
+                return nullptr;
+        }
+
+        av_frame_move_ref(b->frame, src);
+        b->refs.store(1, std::memory_order_relaxed);
+        b->pool = shared_from_this();
+
+        return b.release();
+    }
+
+    void recycle (decoded_frame_buffer * buffer)
+    {
+        std::unique_ptr<decoded_frame_buffer> b {buffer};
+        av_frame_unref(b->frame);
+
+        std::lock_guard<std::mutex> locker{_mtx};
+        _free.push_back(std::move(b));
+    }
+};
+
+} // namespace
+
+void decoded_frame_buffer::release (decoded_frame_buffer * b) noexcept
+{
+    if (!b || b->refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+
+    // Frames may outlive the pipeline: the last frame keeps the pool alive
+    // until the entry is recycled
+    auto p = std::move(b->pool);
+
+    if (p)
+        p->recycle(b);
+    else
+        delete b;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// decoded_frame
+////////////////////////////////////////////////////////////////////////////////
+decoded_frame::decoded_frame (decoded_frame_buffer * buffer, media_type type, double time)
+    : _buffer(buffer)
+    , _type(type)
+    , _time(time)
+{}
+
+decoded_frame::decoded_frame (decoded_frame const & other)
+    : _buffer(other._buffer)
+    , _type(other._type)
+    , _time(other._time)
+{
+    decoded_frame_buffer::add_ref(_buffer);
+}
+
+decoded_frame::decoded_frame (decoded_frame && other) noexcept
+    : _buffer(other._buffer)
+    , _type(other._type)
+    , _time(other._time)
+{
+    other._buffer = nullptr;
+}
+
+decoded_frame & decoded_frame::operator = (decoded_frame const & other)
+{
+    if (this != & other) {
+        decoded_frame_buffer::add_ref(other._buffer);
+        decoded_frame_buffer::release(_buffer);
+        _buffer = other._buffer;
+        _type = other._type;
+        _time = other._time;
+    }
+
+    return *this;
+}
+
+decoded_frame & decoded_frame::operator = (decoded_frame && other) noexcept
+{
+    if (this != & other) {
+        decoded_frame_buffer::release(_buffer);
+        _buffer = other._buffer;
+        _type = other._type;
+        _time = other._time;
+        other._buffer = nullptr;
+    }
+
+    return *this;
+}
+
+decoded_frame::~decoded_frame ()
+{
+    decoded_frame_buffer::release(_buffer);
+}
+
+AVFrame * decoded_frame::native () const noexcept
+{
+    return _buffer ? _buffer->frame : nullptr;
+}
+
+namespace {
+
+struct packet_item
+{
+    enum kind_enum { data, flush, eof };
+
+    AVPacket * pkt {nullptr};
+    int serial {0};
+    kind_enum kind {data};
+};
+
+struct frame_item
+{
+    decoded_frame frame;
+    int serial {0};
+    bool eof {false};
+};
+
+struct stream_context
+{
+    media_type type;
+    int index {-1};
+    AVStream * stream {nullptr};
+    AVCodecContext * codec {nullptr};
+    stream_info info;
+    bounded_queue<packet_item> packets;
+    bounded_queue<frame_item> frames;
+    std::atomic<int> eof_serial {-1};
+    std::thread decoder;
+
+    // Frame received from the decoder, its data are moved into a pooled
+    // entry
+    AVFrame * received {nullptr};
+
+    stream_context (media_type t, std::size_t packet_queue_size, std::size_t frame_queue_size)
+        : type(t)
+        , packets(packet_queue_size)
+        , frames(frame_queue_size)
+    {}
+
+    ~stream_context ()
+    {
+        if (codec)
+            avcodec_free_context(& codec);
+
+        av_frame_free(& received);
+    }
+};
+
+} // namespace
+
+class decode_pipeline::impl
+{
+public:
+    AVFormatContext * format {nullptr};
+    std::unique_ptr<stream_context> streams[2]; // Indexed by `media_type`
+    std::shared_ptr<av_frame_pool> frame_store {std::make_shared<av_frame_pool>()};
+    packet_pool packet_store;
+    std::thread demuxer;
+
+    std::mutex mtx;
+    std::condition_variable cond;
+    bool stopped {false};
+    bool seek_requested {false};
+    double seek_target {0};
+    int seek_serial {0};
+
+    // Serial of the last requested seek. Data tagged with other serial
+    // is stale.
+    std::atomic<int> serial {0};
+
+public:
+    ~impl ()
+    {
+        stop();
+
+        for (auto & st: streams)
+            st.reset();
+
+        if (format)
+            avformat_close_input(& format);
+    }
+
+    stream_context * stream (media_type type) const
+    {
+        return streams[static_cast<int>(type)].get();
+    }
+
+    bool open_stream (media_type type, decode_options const & opts, error_code & ec)
+    {
+        auto mtype = type == media_type::audio ? AVMEDIA_TYPE_AUDIO : AVMEDIA_TYPE_VIDEO;
+        int index = av_find_best_stream(format, mtype, -1, -1, nullptr, 0);
+
+        // Absent stream is not an error
+        if (index < 0)
+            return true;
+
+        auto st = format->streams[index];
+        auto codec = avcodec_find_decoder(st->codecpar->codec_id);
+
+        // Stream can not be decoded, skip it
+        if (!codec)
+            return true;
+
+        std::unique_ptr<stream_context> ctx {new stream_context(type
+            , opts.packet_queue_size, opts.frame_queue_size)};
+
+        ctx->index = index;
+        ctx->stream = st;
+        ctx->codec = avcodec_alloc_context3(codec);
+        ctx->received = av_frame_alloc();
+
+        if (!ctx->codec || !ctx->received) {
+            ec = make_av_error(AVERROR(ENOMEM));
+            return false;
+        }
+
+        int rc = avcodec_parameters_to_context(ctx->codec, st->codecpar);
+
+        if (rc < 0) {
+            ec = make_av_error(rc);
+            return false;
+        }
+
+        ctx->codec->pkt_timebase = st->time_base;
+        ctx->codec->thread_count = opts.decoder_threads;
+        ctx->codec->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+
+        rc = avcodec_open2(ctx->codec, codec, nullptr);
+
+        if (rc < 0) {
+            ec = make_av_error(rc);
+            return false;
+        }
+
+        ctx->info.present = true;
+        ctx->info.codec_name = codec->name;
+
+        if (type == media_type::audio) {
+            ctx->info.sample_rate = ctx->codec->sample_rate;
+#if LIBAVUTIL_VERSION_INT >= AV_VERSION_INT(57, 28, 100)
+            ctx->info.channels = ctx->codec->ch_layout.nb_channels;
+#else
+            ctx->info.channels = ctx->codec->channels;
+#endif
+        } else {
+            ctx->info.width = ctx->codec->width;
+            ctx->info.height = ctx->codec->height;
+        }
+
+        streams[static_cast<int>(type)] = std::move(ctx);
+        return true;
+    }
+
+    void start ()
+    {
+        for (auto & st: streams) {
+            if (st) {
+                auto ctx = st.get();
+                st->decoder = std::thread{[this, ctx] { decode_loop(*ctx); }};
+            }
+        }
+
+        demuxer = std::thread{[this] { demux_loop(); }};
+    }
+
+    void stop ()
+    {
+        {
+            std::lock_guard<std::mutex> locker{mtx};
+            stopped = true;
+        }
+
+        cond.notify_all();
+
+        for (auto & st: streams) {
+            if (st) {
+                st->packets.abort();
+                st->frames.abort();
+            }
+        }
+
+        if (demuxer.joinable())
+            demuxer.join();
+
+        for (auto & st: streams) {
+            if (st) {
+                if (st->decoder.joinable())
+                    st->decoder.join();
+
+                st->packets.clear([this] (packet_item & item) { packet_store.recycle(item.pkt); });
+                st->frames.clear([] (frame_item &) {});
+            }
+        }
+    }
+
+    void push_marker (packet_item::kind_enum kind, int serial)
+    {
+        for (auto & st: streams) {
+            if (st) {
+                packet_item item;
+                item.serial = serial;
+                item.kind = kind;
+                st->packets.push(item);
+            }
+        }
+    }
+
+    void demux_loop ()
+    {
+        int serial = 0;
+        bool eof = false;
+
+        while (true) {
+            bool do_seek = false;
+            double target = 0;
+
+            {
+                std::unique_lock<std::mutex> locker{mtx};
+
+                // Nothing to read until seek
+                if (eof)
+                    cond.wait(locker, [this] { return stopped || seek_requested; });
+
+                if (stopped)
+                    break;
+
+                if (seek_requested) {
+                    seek_requested = false;
+                    do_seek = true;
+                    target = seek_target;
+                    serial = seek_serial;
+                }
+            }
+
+            if (do_seek) {
+                auto ts = static_cast<std::int64_t>(target * AV_TIME_BASE);
+
+                // On failure decoding continues from the current position
+                avformat_seek_file(format, -1, INT64_MIN, ts, INT64_MAX, 0);
+
+                for (auto & st: streams) {
+                    if (st)
+                        st->packets.clear([this] (packet_item & item) { packet_store.recycle(item.pkt); });
+                }
+
+                push_marker(packet_item::flush, serial);
+                eof = false;
+                continue;
+            }
+
+            auto pkt = packet_store.acquire();
+
+            if (!pkt)
+                break;
+
+            int rc = av_read_frame(format, pkt);
+
+            // End of file or unrecoverable error: both finish the streams
+            if (rc < 0) {
+                packet_store.recycle(pkt);
+                push_marker(packet_item::eof, serial);
+                eof = true;
+                continue;
+            }
+
+            stream_context * target_stream = nullptr;
+
+            for (auto & st: streams) {
+                if (st && st->index == pkt->stream_index)
+                    target_stream = st.get();
+            }
+
+            if (!target_stream) {
+                packet_store.recycle(pkt);
+                continue;
+            }
+
+            packet_item item;
+            item.pkt = pkt;
+            item.serial = serial;
+
+            if (!target_stream->packets.push(item)) {
+                packet_store.recycle(pkt);
+                break;
+            }
+        }
+    }
+
+    // Receives all available frames from the decoder. Returns false if the
+    // pipeline is stopped.
+    bool receive_frames (stream_context & st, int serial)
+    {
+        while (true) {
+            // Pooled entry is taken only for a frame actually received
+            // (not for the final EAGAIN / EOF)
+            if (avcodec_receive_frame(st.codec, st.received) < 0)
+                return true;
+
+            auto pts = st.received->best_effort_timestamp;
+
+            if (pts == AV_NOPTS_VALUE)
+                pts = st.received->pts;
+
+            double time = pts == AV_NOPTS_VALUE
+                ? 0.0
+                : pts * av_q2d(st.stream->time_base);
+
+            auto buffer = frame_store->acquire(st.received);
+
+            if (!buffer) {
+                av_frame_unref(st.received);
+                return true;
+            }
+
+            frame_item item;
+            item.frame = decoded_frame{buffer, st.type, time};
+            item.serial = serial;
+
+            if (!st.frames.push(std::move(item)))
+                return false;
+        }
+    }
+
+    void decode_loop (stream_context & st)
+    {
+        int current_serial = 0;
+        packet_item item;
+
+        while (st.packets.pop(item)) {
+            if (item.kind == packet_item::flush) {
+                avcodec_flush_buffers(st.codec);
+                current_serial = item.serial;
+                continue;
+            }
+
+            if (item.serial != current_serial) {
+                packet_store.recycle(item.pkt);
+                continue;
+            }
+
+            // Null packet enters draining mode
+            int rc = avcodec_send_packet(st.codec, item.pkt);
+            packet_store.recycle(item.pkt);
+
+            // Broken packet is skipped
+            if (rc < 0 && item.kind == packet_item::data)
+                continue;
+
+            if (!receive_frames(st, current_serial))
+                break;
+
+            if (item.kind == packet_item::eof) {
+                frame_item eof_item;
+                eof_item.serial = current_serial;
+                eof_item.eof = true;
+
+                if (!st.frames.push(std::move(eof_item)))
+                    break;
+            }
+        }
+    }
+};
+
+decode_pipeline::decode_pipeline () = default;
+
+decode_pipeline::~decode_pipeline ()
+{
+    close();
+}
+
+bool decode_pipeline::open (std::string const & path
+    , decode_options const & opts
+    , error_code & ec)
+{
+    close();
+
+    std::unique_ptr<impl> d {new impl};
+
+    int rc = avformat_open_input(& d->format, path.c_str(), nullptr, nullptr);
+
+    if (rc < 0) {
+        ec = make_av_error(rc);
+        return false;
+    }
+
+    rc = avformat_find_stream_info(d->format, nullptr);
+
+    if (rc < 0) {
+        ec = make_av_error(rc);
+        return false;
+    }
+
+    if (opts.enable_audio && !d->open_stream(media_type::audio, opts, ec))
+        return false;
+
+    if (opts.enable_video && !d->open_stream(media_type::video, opts, ec))
+        return false;
+
+    if (!d->stream(media_type::audio) && !d->stream(media_type::video)) {
+        ec = make_av_error(AVERROR_STREAM_NOT_FOUND);
+        return false;
+    }
+
+    d->start();
+    _d = std::move(d);
+    return true;
+}
+
+void decode_pipeline::close ()
+{
+    _d.reset();
+}
+
+bool decode_pipeline::is_open () const noexcept
+{
+    return !!_d;
+}
+
+double decode_pipeline::duration () const
+{
+    if (!_d || _d->format->duration == AV_NOPTS_VALUE)
+        return 0;
+
+    return static_cast<double>(_d->format->duration) / AV_TIME_BASE;
+}
+
+stream_info decode_pipeline::info (media_type type) const
+{
+    auto st = _d ? _d->stream(type) : nullptr;
+    return st ? st->info : stream_info{};
+}
+
+bool decode_pipeline::read (media_type type, decoded_frame & frame)
+{
+    auto st = _d ? _d->stream(type) : nullptr;
+
+    if (!st)
+        return false;
+
+    frame_item item;
+
+    while (true) {
+        auto serial = _d->serial.load();
+
+        if (st->eof_serial.load() == serial)
+            return false;
+
+        if (!st->frames.pop(item))
+            return false;
+
+        // Decoded before the last seek
+        if (item.serial != _d->serial.load())
+            continue;
+
+        if (item.eof) {
+            st->eof_serial.store(item.serial);
+            return false;
+        }
+
+        frame = std::move(item.frame);
+        return true;
+    }
+}
+
+bool decode_pipeline::seek (double seconds)
+{
+    if (!_d)
+        return false;
+
+    {
+        std::lock_guard<std::mutex> locker{_d->mtx};
+        _d->seek_requested = true;
+        _d->seek_target = seconds;
+        _d->seek_serial = ++_d->serial;
+    }
+
+    // Wake up demuxer and decoders blocked on full queues, queued data is
+    // stale now
+    for (auto & st: _d->streams) {
+        if (st) {
+            st->packets.clear([this] (packet_item & item) { _d->packet_store.recycle(item.pkt); });
+            st->frames.clear([] (frame_item &) {});
+        }
+    }
+
+    _d->cond.notify_all();
+    return true;
+}
+
+}} // namespace multimedia::video
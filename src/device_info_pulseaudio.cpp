@@ -5,9 +5,17 @@
 //
 // Changelog:
 //      2021.08.03 Initial version.
+//      2026.10.19 Added asynchronous device queries.
+//      2026.10.19 Added device control operations.
+//      2026.10.19 Requests in flight are completed on connection failure.
+//      2026.10.19 Added sequential execution of device control operations.
+//      2026.10.19 Failed requests are completed without touching tracked ones.
 ////////////////////////////////////////////////////////////////////////////////
 #include "pfs/multimedia/audio.hpp"
 #include <pulse/pulseaudio.h>
+#include <algorithm>
+#include <functional>
+#include <memory>
 #include <vector>
 
 namespace multimedia {
@@ -283,6 +291,65 @@ public:
         return error != true;
     }
 
+    // Issues all operations at once and waits for completion of all of
+    // them. Returns number of operations that failed to be issued or were
+    // cancelled, or -1 if connection failed.
+    template <typename Operation>
+    int process_operations (std::vector<Operation> const & operations)
+    {
+        while (_context_notifier.connecting()) {
+            if (pa_mainloop_iterate(_mainloop, 1, nullptr) < 0)
+                return -1;
+        }
+
+        if (!_context_notifier.ready())
+            return -1;
+
+        int failed = 0;
+        std::vector<pa_operation *> ops;
+        ops.reserve(operations.size());
+
+        for (auto const & operation: operations) {
+            auto op = operation();
+
+            if (op)
+                ops.push_back(op);
+            else
+                failed++;
+        }
+
+        std::size_t index = 0;
+
+        while (index < ops.size()) {
+            auto state = pa_operation_get_state(ops[index]);
+
+            if (state == PA_OPERATION_RUNNING) {
+                // Operations are cancelled on disconnection, so waiting
+                // is finite.
+                if (pa_mainloop_iterate(_mainloop, 1, nullptr) < 0)
+                    break;
+
+                continue;
+            }
+
+            if (state == PA_OPERATION_CANCELLED)
+                failed++;
+
+            index++;
+        }
+
+        for (auto op: ops) {
+            if (pa_operation_get_state(op) == PA_OPERATION_RUNNING) {
+                pa_operation_cancel(op);
+                failed++;
+            }
+
+            pa_operation_unref(op);
+        }
+
+        return failed;
+    }
+
     void end ()
     {
         if (_context) {
@@ -395,4 +462,472 @@ MULTIMEDIA__EXPORT std::vector<device_info> fetch_devices (device_mode mode)
     return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Device control
+////////////////////////////////////////////////////////////////////////////////
+class control_result final
+{
+public:
+    int failed {0};
+
+    static void callback (pa_context *, int success, void * userdata)
+    {
+        if (!success)
+            static_cast<control_result *>(userdata)->failed++;
+    }
+};
+
+MULTIMEDIA__EXPORT bool control_batch::execute (execution mode, error_code & ec)
+{
+    std::vector<operation> ops;
+    ops.swap(_ops);
+
+    if (ops.empty())
+        return true;
+
+    session sess;
+
+    if (!sess.begin()) {
+        ec = make_error_code(errc::backend_error);
+        return false;
+    }
+
+    control_result result;
+    std::vector<std::function<pa_operation * ()>> issuers;
+    issuers.reserve(ops.size());
+
+    for (auto const & op: ops) {
+        issuers.emplace_back([& sess, & op, & result] () -> pa_operation * {
+            auto c = sess.context();
+            auto name = op.name.c_str();
+            bool input = op.mode == device_mode::input;
+
+            switch (op.type) {
+                case operation_type::volume: {
+                    // Single channel volume is applied to all channels
+                    // keeping the balance.
+                    auto v = op.volume < 0.f ? 0.f : op.volume;
+                    pa_cvolume cv;
+                    pa_cvolume_set(& cv, 1, static_cast<pa_volume_t>(v * PA_VOLUME_NORM + .5f));
+
+                    return input
+                        ? pa_context_set_source_volume_by_name(c, name, & cv, control_result::callback, & result)
+                        : pa_context_set_sink_volume_by_name(c, name, & cv, control_result::callback, & result);
+                }
+
+                case operation_type::mute:
+                    return input
+                        ? pa_context_set_source_mute_by_name(c, name, op.mute ? 1 : 0, control_result::callback, & result)
+                        : pa_context_set_sink_mute_by_name(c, name, op.mute ? 1 : 0, control_result::callback, & result);
+
+                case operation_type::default_device:
+                    return input
+                        ? pa_context_set_default_source(c, name, control_result::callback, & result)
+                        : pa_context_set_default_sink(c, name, control_result::callback, & result);
+            }
+
+            return nullptr;
+        });
+    }
+
+    int failed = 0;
+
+    if (mode == execution::sequential) {
+        for (auto const & issuer: issuers) {
+            // Operation is not awaited if the connection is lost
+            if (!sess.process_operation(issuer)
+                    || pa_context_get_state(sess.context()) != PA_CONTEXT_READY) {
+                failed++;
+            }
+        }
+    } else {
+        failed = sess.process_operations(issuers);
+    }
+
+    sess.end();
+
+    if (failed != 0 || result.failed != 0) {
+        ec = make_error_code(errc::backend_error);
+        return false;
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Asynchronous requests
+////////////////////////////////////////////////////////////////////////////////
+
+// Request in flight. Completed by its own callbacks or, if the connection
+// fails before that, by the session with an empty result: PulseAudio
+// cancels operations of the failed context without calling their callbacks.
+class async_operation
+{
+    pa_operation * _op {nullptr};
+
+public:
+    virtual ~async_operation ()
+    {
+        if (_op)
+            pa_operation_unref(_op);
+    }
+
+    // Keeps reference to the current (last chained) operation.
+    void attach (pa_operation * op)
+    {
+        if (_op)
+            pa_operation_unref(_op);
+
+        _op = op;
+    }
+
+    // Guarantees that callbacks of the operation are never called.
+    void cancel ()
+    {
+        if (_op)
+            pa_operation_cancel(_op);
+    }
+
+    // Completes the request with empty result and deletes it.
+    virtual void abort () = 0;
+};
+
+// Connection to the server shared by all asynchronous requests. Requests are
+// issued and completed by the single PulseAudio event loop thread, so no
+// thread is blocked while a request is outstanding. Failed connection is
+// reestablished by the next request.
+class async_session final
+{
+public:
+    // Issues request operations, `nullptr` context means connection failure
+    // (the request may be called without the event loop lock then, so it
+    // must not track or untrack operations).
+    using request = std::function<void (pa_context *)>;
+
+private:
+    pa_threaded_mainloop * _mainloop {nullptr};
+    pa_context * _context {nullptr};
+    std::vector<request> _pending; // Requests waiting for the connection
+    std::vector<async_operation *> _operations; // Requests in flight
+
+private:
+    async_session ()
+    {
+        _mainloop = pa_threaded_mainloop_new();
+
+        if (_mainloop && pa_threaded_mainloop_start(_mainloop) < 0) {
+            pa_threaded_mainloop_free(_mainloop);
+            _mainloop = nullptr;
+        }
+    }
+
+    // Called from the event loop thread
+    static void state_callback (pa_context * c, void * userdata)
+    {
+        auto self = static_cast<async_session *>(userdata);
+
+        switch (pa_context_get_state(c)) {
+            case PA_CONTEXT_READY:
+                self->flush(c);
+                break;
+
+            case PA_CONTEXT_FAILED:
+            case PA_CONTEXT_TERMINATED:
+                self->abort_operations();
+                self->flush(nullptr);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    void flush (pa_context * c)
+    {
+        std::vector<request> pending;
+        pending.swap(_pending);
+
+        for (auto & r: pending)
+            r(c);
+    }
+
+    void abort_operations ()
+    {
+        std::vector<async_operation *> operations;
+        operations.swap(_operations);
+
+        for (auto op: operations) {
+            op->cancel();
+            op->abort();
+        }
+    }
+
+public:
+    ~async_session ()
+    {
+        if (_mainloop) {
+            pa_threaded_mainloop_stop(_mainloop);
+
+            if (_context) {
+                pa_context_disconnect(_context);
+                pa_context_unref(_context);
+            }
+
+            pa_threaded_mainloop_free(_mainloop);
+        }
+    }
+
+    static async_session & instance ()
+    {
+        static async_session session;
+        return session;
+    }
+
+    // Executes request when the context becomes ready. Thread-safe, may be
+    // called from the event loop thread (e.g. from completion callback).
+    void submit (request r)
+    {
+        if (!_mainloop) {
+            r(nullptr);
+            return;
+        }
+
+        bool in_loop = pa_threaded_mainloop_in_thread(_mainloop) != 0;
+
+        if (!in_loop)
+            pa_threaded_mainloop_lock(_mainloop);
+
+        if (_context) {
+            auto state = pa_context_get_state(_context);
+
+            if (state == PA_CONTEXT_FAILED || state == PA_CONTEXT_TERMINATED) {
+                pa_context_unref(_context);
+                _context = nullptr;
+            }
+        }
+
+        if (!_context) {
+            _context = pa_context_new(pa_threaded_mainloop_get_api(_mainloop)
+                , "pfs::multimedia");
+
+            if (_context) {
+                pa_context_set_state_callback(_context, state_callback, this);
+
+                auto rc = pa_context_connect(_context
+                    , nullptr             // Connect to default server
+                    , PA_CONTEXT_NOFLAGS
+                    , nullptr);
+
+                // Connection error
+                if (rc < 0) {
+                    pa_context_unref(_context);
+                    _context = nullptr;
+                }
+            }
+        }
+
+        bool failed = !_context;
+
+        if (!failed) {
+            if (pa_context_get_state(_context) == PA_CONTEXT_READY)
+                r(_context);
+            else
+                _pending.push_back(std::move(r));
+        }
+
+        if (!in_loop)
+            pa_threaded_mainloop_unlock(_mainloop);
+
+        if (failed)
+            r(nullptr);
+    }
+
+    // Registers request with issued operation. Must be called from the
+    // event loop thread or from the request passed to `submit()`.
+    void track (async_operation * op)
+    {
+        _operations.push_back(op);
+    }
+
+    // Unregisters completed request (called from the event loop thread).
+    void untrack (async_operation * op)
+    {
+        _operations.erase(std::remove(_operations.begin(), _operations.end(), op)
+            , _operations.end());
+    }
+};
+
+struct fetch_devices_request: async_operation
+{
+    std::vector<device_info> result;
+    std::function<void (std::vector<device_info>)> callback;
+
+    template <typename NativeInfo>
+    static void callback_helper (pa_context *, NativeInfo const * i, int eol, void * userdata)
+    {
+        auto req = static_cast<fetch_devices_request *>(userdata);
+
+        if (eol == 0) {
+            req->result.emplace_back();
+            auto & di = req->result.back();
+            di.name = i->name;
+            di.readable_name = i->description;
+            return;
+        }
+
+        // End of the list (eol > 0) or failure (eol < 0)
+        complete(req);
+    }
+
+    // Completes tracked request (called from the event loop thread).
+    static void complete (fetch_devices_request * req)
+    {
+        async_session::instance().untrack(req);
+        finish(req);
+    }
+
+    // Completes request that is not tracked: failed to issue or aborted.
+    // May be called without the event loop lock.
+    static void finish (fetch_devices_request * req)
+    {
+        std::unique_ptr<fetch_devices_request> guard {req};
+        req->callback(std::move(req->result));
+    }
+
+    void abort () override
+    {
+        result.clear();
+        finish(this);
+    }
+};
+
+struct default_device_request: async_operation
+{
+    device_mode mode;
+    device_info result;
+    std::function<void (device_info)> callback;
+
+    template <typename NativeInfo>
+    static void device_callback (pa_context *, NativeInfo const * i, int eol, void * userdata)
+    {
+        auto req = static_cast<default_device_request *>(userdata);
+
+        if (eol == 0) {
+            req->result.name = i->name;
+            req->result.readable_name = i->description;
+            return;
+        }
+
+        complete(req);
+    }
+
+    static void server_callback (pa_context * c, pa_server_info const * i, void * userdata)
+    {
+        auto req = static_cast<default_device_request *>(userdata);
+        char const * name = nullptr;
+
+        if (i) {
+            name = req->mode == device_mode::input
+                ? i->default_source_name
+                : i->default_sink_name;
+        }
+
+        if (!name) {
+            complete(req);
+            return;
+        }
+
+        // Chained operation is issued from the event loop thread
+        auto op = req->mode == device_mode::input
+            ? pa_context_get_source_info_by_name(c, name, device_callback<pa_source_info>, req)
+            : pa_context_get_sink_info_by_name(c, name, device_callback<pa_sink_info>, req);
+
+        if (!op) {
+            complete(req);
+            return;
+        }
+
+        req->attach(op);
+    }
+
+    // Completes tracked request (called from the event loop thread).
+    static void complete (default_device_request * req)
+    {
+        async_session::instance().untrack(req);
+        finish(req);
+    }
+
+    // Completes request that is not tracked: failed to issue or aborted.
+    // May be called without the event loop lock.
+    static void finish (default_device_request * req)
+    {
+        std::unique_ptr<default_device_request> guard {req};
+        req->callback(std::move(req->result));
+    }
+
+    void abort () override
+    {
+        result = device_info{};
+        finish(this);
+    }
+};
+
+static void default_device_async (device_mode mode, std::function<void (device_info)> callback)
+{
+    auto req = new default_device_request;
+    req->mode = mode;
+    req->callback = std::move(callback);
+
+    async_session::instance().submit([req] (pa_context * c) {
+        auto op = c
+            ? pa_context_get_server_info(c, default_device_request::server_callback, req)
+            : nullptr;
+
+        if (!op) {
+            default_device_request::finish(req);
+            return;
+        }
+
+        req->attach(op);
+        async_session::instance().track(req);
+    });
+}
+
+MULTIMEDIA__EXPORT void default_input_device_async (std::function<void (device_info)> callback)
+{
+    default_device_async(device_mode::input, std::move(callback));
+}
+
+MULTIMEDIA__EXPORT void default_output_device_async (std::function<void (device_info)> callback)
+{
+    default_device_async(device_mode::output, std::move(callback));
+}
+
+MULTIMEDIA__EXPORT void fetch_devices_async (device_mode mode
+    , std::function<void (std::vector<device_info>)> callback)
+{
+    auto req = new fetch_devices_request;
+    req->callback = std::move(callback);
+
+    async_session::instance().submit([mode, req] (pa_context * c) {
+        pa_operation * op = nullptr;
+
+        if (c) {
+            op = mode == device_mode::input
+                ? pa_context_get_source_info_list(c
+                    , fetch_devices_request::callback_helper<pa_source_info>, req)
+                : pa_context_get_sink_info_list(c
+                    , fetch_devices_request::callback_helper<pa_sink_info>, req);
+        }
+
+        if (!op) {
+            fetch_devices_request::finish(req);
+            return;
+        }
+
+        req->attach(op);
+        async_session::instance().track(req);
+    });
+}
+
 }} // namespace multimedia::audio
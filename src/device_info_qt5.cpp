@@ -5,9 +5,12 @@
 //
 // Changelog:
 //      2022.01.20 Initial version.
+//      2026.10.19 Added asynchronous device queries.
+//      2026.10.19 Added device control operations.
 ////////////////////////////////////////////////////////////////////////////////
 #include "pfs/multimedia/audio.hpp"
 #include <QAudioDeviceInfo>
+#include <system_error>
 #include <vector>
 
 namespace multimedia {
@@ -52,5 +55,34 @@ MULTIMEDIA__EXPORT std::vector<device_info> fetch_devices (device_mode mode)
     return result;
 }
 
+// Asynchronous requests are completed synchronously by this backend
+MULTIMEDIA__EXPORT void default_input_device_async (std::function<void (device_info)> callback)
+{
+    callback(default_input_device());
+}
+
+MULTIMEDIA__EXPORT void default_output_device_async (std::function<void (device_info)> callback)
+{
+    callback(default_output_device());
+}
+
+MULTIMEDIA__EXPORT void fetch_devices_async (device_mode mode
+    , std::function<void (std::vector<device_info>)> callback)
+{
+    callback(fetch_devices(mode));
+}
+
+// Qt Multimedia does not provide system wide device control
+MULTIMEDIA__EXPORT bool control_batch::execute (execution, error_code & ec)
+{
+    bool success = _ops.empty();
+    _ops.clear();
+
+    if (!success)
+        ec = std::make_error_code(std::errc::operation_not_supported);
+
+    return success;
+}
+
 }} // namespace multimedia::audio
 
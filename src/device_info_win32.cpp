@@ -5,11 +5,17 @@
 //
 // Changelog:
 //      2021.08.07 Initial version.
+//      2026.10.19 Added asynchronous device queries.
+//      2026.10.19 Added device control operations.
+//      2026.10.19 Invalid device name is reported as control operation error.
 ////////////////////////////////////////////////////////////////////////////////
 #include "pfs/multimedia/audio.hpp"
 #include <mmdeviceapi.h>
+#include <endpointvolume.h> // IAudioEndpointVolume
 #include <strmif.h> // ICreateDevEnum
 #include <functiondiscoverykeys_devpkey.h> // PROPERTYKEY
+#include <string>
+#include <system_error>
 #include <vector>
 #include <cwchar>
 
@@ -31,6 +37,22 @@ static std::string convert_wide (LPCWSTR wstr)
     return result;
 }
 
+// Returns false if `str` contains invalid multibyte sequence.
+static bool convert_multibyte (std::string const & str, std::wstring & result)
+{
+    char const * s = str.c_str();
+    std::mbstate_t state = std::mbstate_t();
+    std::size_t len = std::mbsrtowcs(nullptr, & s, 0, & state);
+
+    if (len == static_cast<std::size_t>(-1))
+        return false;
+
+    result.assign(len + 1, L'\x0');
+    std::mbsrtowcs(& result[0], & s, len + 1, & state);
+    result.resize(len);
+    return true;
+}
+
 class IMMDeviceEnumerator_initializer
 {
     HRESULT hrCoInit {S_FALSE};
@@ -323,4 +345,97 @@ MULTIMEDIA__EXPORT std::vector<device_info> fetch_devices (device_mode mode)
     return result;
 }
 
+// Asynchronous requests are completed synchronously by this backend
+MULTIMEDIA__EXPORT void default_input_device_async (std::function<void (device_info)> callback)
+{
+    callback(default_input_device());
+}
+
+MULTIMEDIA__EXPORT void default_output_device_async (std::function<void (device_info)> callback)
+{
+    callback(default_output_device());
+}
+
+MULTIMEDIA__EXPORT void fetch_devices_async (device_mode mode
+    , std::function<void (std::vector<device_info>)> callback)
+{
+    callback(fetch_devices(mode));
+}
+
+// Volume and mute are controlled through the endpoint volume interface.
+// There is no public API to change default endpoint, so this operation
+// is not supported. Endpoint calls are synchronous, so operations are
+// always executed sequentially.
+MULTIMEDIA__EXPORT bool control_batch::execute (execution, error_code & ec)
+{
+    std::vector<operation> ops;
+    ops.swap(_ops);
+
+    if (ops.empty())
+        return true;
+
+    IMMDeviceEnumerator * pEnumerator = nullptr;
+    IMMDeviceEnumerator_initializer enumerator_initializer {& pEnumerator};
+
+    if (!pEnumerator) {
+        ec = make_error_code(errc::backend_error);
+        return false;
+    }
+
+    bool success = true;
+
+    auto set_error = [& success, & ec] (error_code const & err) {
+        if (success)
+            ec = err;
+
+        success = false;
+    };
+
+    for (auto const & op: ops) {
+        if (op.type == operation_type::default_device) {
+            set_error(std::make_error_code(std::errc::operation_not_supported));
+            continue;
+        }
+
+        // https://docs.microsoft.com/en-us/windows/win32/api/mmdeviceapi/nf-mmdeviceapi-immdeviceenumerator-getdevice
+        std::wstring id;
+
+        if (!convert_multibyte(op.name, id)) {
+            set_error(std::make_error_code(std::errc::illegal_byte_sequence));
+            continue;
+        }
+
+        IMMDevice * pEndpoint = nullptr;
+        auto hr = pEnumerator->GetDevice(id.c_str(), & pEndpoint);
+        IMMDevice_guard endpoint_guard {& pEndpoint};
+
+        IAudioEndpointVolume * pVolume = nullptr;
+
+        if (SUCCEEDED(hr) && pEndpoint) {
+            hr = pEndpoint->Activate(__uuidof(IAudioEndpointVolume), CLSCTX_ALL
+                , nullptr, reinterpret_cast<void **>(& pVolume));
+        }
+
+        if (SUCCEEDED(hr) && pVolume) {
+            if (op.type == operation_type::volume) {
+                // Scalar volume is in range [0.0, 1.0]
+                auto v = op.volume < 0.f ? 0.f : (op.volume > 1.f ? 1.f : op.volume);
+                hr = pVolume->SetMasterVolumeLevelScalar(v, nullptr);
+            } else {
+                hr = pVolume->SetMute(op.mute ? TRUE : FALSE, nullptr);
+            }
+        }
+
+        if (pVolume) {
+            pVolume->Release();
+            pVolume = nullptr;
+        }
+
+        if (FAILED(hr) || !pEndpoint)
+            set_error(make_error_code(errc::backend_error));
+    }
+
+    return success;
+}
+
 }} // namespace multimedia::audio
@@ -0,0 +1,143 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Added fitted clock line mapping.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/multimedia/drift_compensator.hpp"
+#include <algorithm>
+
+namespace multimedia {
+namespace audio {
+
+clock_drift_estimator::clock_drift_estimator (double nominal_rate, std::size_t window)
+    : _nominal_rate(nominal_rate)
+    , _samples(std::max<std::size_t>(2, window))
+    , _rate(nominal_rate)
+{}
+
+void clock_drift_estimator::reset ()
+{
+    _head = 0;
+    _count = 0;
+    _rate = _nominal_rate;
+    _origin = clock_sample{0, 0};
+    _offset = 0;
+}
+
+void clock_drift_estimator::update (clock_sample const & sample)
+{
+    auto capacity = _samples.size();
+
+    // Ignore non-monotonic timestamps
+    if (_count > 0) {
+        auto const & last = _samples[(_head + capacity - 1) % capacity];
+
+        if (sample.time_usec <= last.time_usec || sample.frames < last.frames)
+            return;
+    }
+
+    _samples[_head] = sample;
+    _head = (_head + 1) % capacity;
+    _count = std::min(_count + 1, capacity);
+
+    if (_count < 2) {
+        _origin = sample;
+        _offset = 0;
+        return;
+    }
+
+    // Least squares fit of frames = rate * time + b. Values are taken
+    // relative to the oldest sample to keep precision.
+    auto const & origin = _samples[(_head + capacity - _count) % capacity];
+    double sum_t = 0, sum_f = 0, sum_tt = 0, sum_tf = 0;
+
+    for (std::size_t i = 0; i < _count; i++) {
+        auto const & s = _samples[(_head + capacity - _count + i) % capacity];
+        double t = static_cast<double>(s.time_usec - origin.time_usec) * 1e-6;
+        double f = static_cast<double>(s.frames - origin.frames);
+        sum_t += t;
+        sum_f += f;
+        sum_tt += t * t;
+        sum_tf += t * f;
+    }
+
+    double n = static_cast<double>(_count);
+    double denom = n * sum_tt - sum_t * sum_t;
+
+    if (denom > 0) {
+        double rate = (n * sum_tf - sum_t * sum_f) / denom;
+
+        // Reject obviously wrong estimations (e.g. stream was corked)
+        if (rate > _nominal_rate * 0.9 && rate < _nominal_rate * 1.1) {
+            _rate = rate;
+            _origin = origin;
+            _offset = (sum_f - rate * sum_t) / n;
+        }
+    }
+}
+
+drift_compensator::drift_compensator (drift_options const & opts)
+    : _opts(opts)
+    , _input_clock(opts.sample_rate, opts.window)
+    , _output_clock(opts.sample_rate, opts.window)
+    , _resampler(opts.channels)
+{}
+
+void drift_compensator::update_ratio ()
+{
+    double ratio = _output_clock.rate() / _input_clock.rate() * _correction;
+    double limit = _opts.max_correction_ppm * 1e-6;
+
+    ratio = std::max(1.0 - limit, std::min(1.0 + limit, ratio));
+    _resampler.set_ratio(ratio);
+}
+
+void drift_compensator::update_input_clock (clock_sample const & sample)
+{
+    _input_clock.update(sample);
+    update_ratio();
+}
+
+void drift_compensator::update_output_clock (clock_sample const & sample)
+{
+    _output_clock.update(sample);
+    update_ratio();
+}
+
+void drift_compensator::update_latency (std::size_t queued_frames)
+{
+    // Latency error in milliseconds: positive when too many frames are
+    // queued, so fewer frames must be produced (ratio decreased).
+    double error_ms = (static_cast<double>(queued_frames)
+        - static_cast<double>(_opts.target_latency_frames)) * 1000.0 / _opts.sample_rate;
+
+    double limit_ppm = _opts.max_correction_ppm;
+
+    _integral += error_ms;
+
+    // Anti-windup
+    if (_opts.ki > 0)
+        _integral = std::max(-limit_ppm / _opts.ki, std::min(limit_ppm / _opts.ki, _integral));
+
+    double correction_ppm = -(_opts.kp * error_ms + _opts.ki * _integral);
+    correction_ppm = std::max(-limit_ppm, std::min(limit_ppm, correction_ppm));
+
+    _correction = 1.0 + correction_ppm * 1e-6;
+    update_ratio();
+}
+
+void drift_compensator::reset ()
+{
+    _input_clock.reset();
+    _output_clock.reset();
+    _resampler.reset();
+    _integral = 0;
+    _correction = 1.0;
+    _resampler.set_ratio(1.0);
+}
+
+}} // namespace multimedia::audio
@@ -0,0 +1,170 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// References:
+//      1. FLAC/stream_encoder.h: Stream encoder interface
+//         (https://xiph.org/flac/api/group__flac__stream__encoder.html)
+//
+// Changelog:
+//      2026.10.19 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/multimedia/audio_encoders.hpp"
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <FLAC/stream_encoder.h>
+
+namespace multimedia {
+namespace audio {
+
+namespace {
+
+class flac_adapter final: public encoder
+{
+    FLAC__StreamEncoder * _enc {nullptr};
+    std::size_t _channels {0};
+    float _scale {0};
+    std::vector<FLAC__int32> _buffer;
+
+    // Emitter of the current `encode()`/`flush()` call
+    packet_emitter const * _emit {nullptr};
+
+    // Stream header written by `FLAC__stream_encoder_init_stream()`,
+    // emitted before the first frame
+    std::vector<std::uint8_t> _header;
+
+    std::uint64_t _written {0};   // Number of frames emitted
+    bool _finished {false};
+
+private:
+    static FLAC__StreamEncoderWriteStatus write_callback (FLAC__StreamEncoder const *
+        , FLAC__byte const buffer[]
+        , std::size_t bytes
+        , unsigned samples
+        , unsigned /*current_frame*/
+        , void * client_data)
+    {
+        static_cast<flac_adapter *>(client_data)->write(buffer, bytes, samples);
+        return FLAC__STREAM_ENCODER_WRITE_STATUS_OK;
+    }
+
+    void write (std::uint8_t const * data, std::size_t size, unsigned samples)
+    {
+        // Header on initialization or remaining output on destruction of the
+        // encoder that was not flushed
+        if (_emit == nullptr) {
+            if (_written == 0)
+                _header.insert(_header.end(), data, data + size);
+
+            return;
+        }
+
+        (*_emit)(data, size, _written);
+        _written += samples;
+    }
+
+    void emit_header (packet_emitter const & emit)
+    {
+        if (_header.empty())
+            return;
+
+        emit(_header.data(), _header.size(), 0);
+        _header.clear();
+        _header.shrink_to_fit();
+    }
+
+public:
+    flac_adapter (flac_encoder_options const & opts)
+        : _enc(FLAC__stream_encoder_new())
+        , _channels(static_cast<std::size_t>(opts.channels))
+        , _scale(static_cast<float>((1 << (opts.bits_per_sample - 1)) - 1))
+    {}
+
+    ~flac_adapter ()
+    {
+        if (_enc != nullptr)
+            FLAC__stream_encoder_delete(_enc);
+    }
+
+    bool init (flac_encoder_options const & opts)
+    {
+        if (_enc == nullptr)
+            return false;
+
+        auto success = FLAC__stream_encoder_set_channels(_enc, static_cast<unsigned>(opts.channels))
+            && FLAC__stream_encoder_set_bits_per_sample(_enc, static_cast<unsigned>(opts.bits_per_sample))
+            && FLAC__stream_encoder_set_sample_rate(_enc, static_cast<unsigned>(opts.sample_rate))
+            && FLAC__stream_encoder_set_compression_level(_enc, static_cast<unsigned>(opts.compression_level));
+
+        // Block size is set after the compression level, which resets it
+        if (success && opts.block_size > 0)
+            success = FLAC__stream_encoder_set_blocksize(_enc, static_cast<unsigned>(opts.block_size));
+
+        return success && FLAC__stream_encoder_init_stream(_enc, & write_callback
+            , nullptr, nullptr, nullptr, this) == FLAC__STREAM_ENCODER_INIT_STATUS_OK;
+    }
+
+    void encode (float const * samples
+        , std::size_t frames
+        , std::uint64_t /*pts*/
+        , packet_emitter const & emit) override
+    {
+        if (_finished)
+            return;
+
+        emit_header(emit);
+
+        auto count = frames * _channels;
+        _buffer.resize(count);
+
+        for (std::size_t i = 0; i < count; i++) {
+            auto x = std::max(-1.f, std::min(1.f, samples[i]));
+            _buffer[i] = static_cast<FLAC__int32>(std::lrint(x * _scale));
+        }
+
+        // The encoder fails only on write errors, which the adapter never
+        // reports
+        _emit = & emit;
+        FLAC__stream_encoder_process_interleaved(_enc, _buffer.data(), static_cast<unsigned>(frames));
+        _emit = nullptr;
+    }
+
+    void flush (packet_emitter const & emit) override
+    {
+        if (_finished)
+            return;
+
+        emit_header(emit);
+
+        _emit = & emit;
+        FLAC__stream_encoder_finish(_enc);
+        _emit = nullptr;
+        _finished = true;
+    }
+};
+
+} // namespace
+
+std::unique_ptr<encoder> make_flac_encoder (flac_encoder_options const & opts, error_code & ec)
+{
+    if (opts.channels < 1 || opts.channels > 8
+            || (opts.bits_per_sample != 16 && opts.bits_per_sample != 24)
+            || opts.compression_level < 0 || opts.compression_level > 8
+            || opts.sample_rate <= 0) {
+        ec = std::make_error_code(std::errc::invalid_argument);
+        return nullptr;
+    }
+
+    std::unique_ptr<flac_adapter> result {new flac_adapter {opts}};
+
+    if (!result->init(opts)) {
+        ec = make_error_code(errc::backend_error);
+        return nullptr;
+    }
+
+    return std::unique_ptr<encoder>{result.release()};
+}
+
+}} // namespace multimedia::audio
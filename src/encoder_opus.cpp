@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// References:
+//      1. Opus API - Encoder (https://opus-codec.org/docs/opus_api-1.3.1/group__opus__encoder.html)
+//
+// Changelog:
+//      2026.10.19 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/multimedia/audio_encoders.hpp"
+#include <algorithm>
+#include <vector>
+#include <cstring>
+#include <opus.h>
+
+namespace multimedia {
+namespace audio {
+
+namespace {
+
+// Recommended maximum packet size (see `opus_encode()`)
+constexpr std::size_t MAX_PACKET_SIZE = 4000;
+
+class opus_adapter final: public encoder
+{
+    OpusEncoder * _enc {nullptr};
+    std::size_t _channels {0};
+    std::size_t _frame_size {0};
+    std::vector<float> _buffer;  // Incomplete packet
+    std::size_t _fill {0};       // Number of frames in `_buffer`
+    std::uint64_t _pts {0};      // Index of the first frame in `_buffer`
+    std::vector<std::uint8_t> _packet;
+
+private:
+    void encode_buffer (packet_emitter const & emit)
+    {
+        auto n = opus_encode_float(_enc, _buffer.data(), static_cast<int>(_frame_size)
+            , _packet.data(), static_cast<opus_int32>(_packet.size()));
+
+        // Arguments are validated on creation, so the encoder can not fail
+        if (n > 0)
+            emit(_packet.data(), static_cast<std::size_t>(n), _pts);
+
+        _fill = 0;
+    }
+
+public:
+    opus_adapter (OpusEncoder * enc, opus_encoder_options const & opts)
+        : _enc(enc)
+        , _channels(static_cast<std::size_t>(opts.channels))
+        , _frame_size(opts.frame_size)
+        , _buffer(opts.frame_size * _channels)
+        , _packet(MAX_PACKET_SIZE)
+    {}
+
+    ~opus_adapter ()
+    {
+        opus_encoder_destroy(_enc);
+    }
+
+    void encode (float const * samples
+        , std::size_t frames
+        , std::uint64_t pts
+        , packet_emitter const & emit) override
+    {
+        std::size_t offset = 0;
+
+        while (offset < frames) {
+            if (_fill == 0)
+                _pts = pts + offset;
+
+            auto n = std::min(_frame_size - _fill, frames - offset);
+
+            std::memcpy(_buffer.data() + _fill * _channels, samples + offset * _channels
+                , n * _channels * sizeof(float));
+
+            _fill += n;
+            offset += n;
+
+            if (_fill == _frame_size)
+                encode_buffer(emit);
+        }
+    }
+
+    void flush (packet_emitter const & emit) override
+    {
+        if (_fill == 0)
+            return;
+
+        std::fill(_buffer.begin() + static_cast<std::ptrdiff_t>(_fill * _channels), _buffer.end(), 0.f);
+        encode_buffer(emit);
+    }
+};
+
+int application_of (opus_application app)
+{
+    switch (app) {
+        case opus_application::voip:
+            return OPUS_APPLICATION_VOIP;
+        case opus_application::low_delay:
+            return OPUS_APPLICATION_RESTRICTED_LOWDELAY;
+        case opus_application::audio:
+        default:
+            break;
+    }
+
+    return OPUS_APPLICATION_AUDIO;
+}
+
+// Opus accepts packets of 2.5, 5, 10, 20, 40 or 60 ms
+bool valid_frame_size (std::size_t frame_size, int sample_rate)
+{
+    if (sample_rate <= 0)
+        return false;
+
+    // Duration in units of 2.5 ms
+    auto units = frame_size * 400;
+    auto rate = static_cast<std::size_t>(sample_rate);
+
+    if (units % rate != 0)
+        return false;
+
+    switch (units / rate) {
+        case 1: case 2: case 4: case 8: case 16: case 24:
+            return true;
+        default:
+            break;
+    }
+
+    return false;
+}
+
+} // namespace
+
+std::unique_ptr<encoder> make_opus_encoder (opus_encoder_options const & opts, error_code & ec)
+{
+    if (opts.channels < 1 || opts.channels > 2 || !valid_frame_size(opts.frame_size, opts.sample_rate)
+            || opts.complexity < 0 || opts.complexity > 10 || opts.bitrate < 0) {
+        ec = std::make_error_code(std::errc::invalid_argument);
+        return nullptr;
+    }
+
+    int rc = OPUS_OK;
+    auto enc = opus_encoder_create(opts.sample_rate, opts.channels, application_of(opts.application), & rc);
+
+    if (rc != OPUS_OK || enc == nullptr) {
+        // Unsupported sample rate
+        ec = rc == OPUS_BAD_ARG
+            ? std::make_error_code(std::errc::invalid_argument)
+            : make_error_code(errc::backend_error);
+        return nullptr;
+    }
+
+    std::unique_ptr<encoder> result {new opus_adapter {enc, opts}};
+
+    if (opts.bitrate > 0)
+        rc = opus_encoder_ctl(enc, OPUS_SET_BITRATE(opts.bitrate));
+
+    if (rc == OPUS_OK)
+        rc = opus_encoder_ctl(enc, OPUS_SET_COMPLEXITY(opts.complexity));
+
+    if (rc != OPUS_OK) {
+        ec = make_error_code(errc::backend_error);
+        return nullptr;
+    }
+
+    return result;
+}
+
+}} // namespace multimedia::audio
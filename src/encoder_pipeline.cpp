@@ -0,0 +1,253 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Lock-free run queues and wake up on the submit path.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/multimedia/encoder_pipeline.hpp"
+#include "mpmc_queue.hpp"
+#include "semaphore.hpp"
+#include <algorithm>
+#include <thread>
+#include <cstring>
+
+namespace multimedia {
+namespace audio {
+
+struct encoder_pipeline::worker
+{
+    // Lane is in at most one run queue at a time (see `lane::scheduled`),
+    // so the queue of `max_streams` capacity never overflows
+    mpmc_queue<lane *> queue;
+    std::thread thread;
+
+    explicit worker (std::size_t capacity)
+        : queue(capacity)
+    {}
+};
+
+encoder_pipeline::encoder_pipeline (encoder_pipeline_options const & opts, sink_type sink)
+    : _opts(opts)
+    , _sink(std::move(sink))
+{
+    if (_opts.threads == 0)
+        _opts.threads = std::max(1u, std::thread::hardware_concurrency());
+
+    _opts.queue_capacity = std::max<std::size_t>(1, _opts.queue_capacity);
+    _opts.batch = std::max<std::size_t>(1, _opts.batch);
+
+    _lanes.resize(_opts.max_streams);
+    _ready.reset(new semaphore);
+
+    for (std::size_t i = 0; i < _opts.threads; i++)
+        _workers.emplace_back(new worker{_opts.max_streams});
+
+    for (std::size_t i = 0; i < _opts.threads; i++)
+        _workers[i]->thread = std::thread(& encoder_pipeline::run, this, i);
+}
+
+encoder_pipeline::~encoder_pipeline ()
+{
+    stop();
+}
+
+int encoder_pipeline::add_stream (std::unique_ptr<encoder> enc, int channels)
+{
+    std::lock_guard<std::mutex> locker{_lanes_mtx};
+
+    auto id = _lane_count.load();
+
+    if (id >= _lanes.size() || _stopped)
+        return -1;
+
+    std::unique_ptr<lane> l {new lane};
+    l->id = static_cast<int>(id);
+    l->channels = std::max(1, channels);
+    l->enc = std::move(enc);
+    l->ring.resize(_opts.queue_capacity);
+
+    for (auto & f: l->ring)
+        f.samples.resize(_opts.max_frames * static_cast<std::size_t>(l->channels));
+
+    int stream = l->id;
+
+    l->emit = [this, stream] (std::uint8_t const * data, std::size_t size, std::uint64_t pts) {
+        if (_sink)
+            _sink(encoded_packet{stream, data, size, pts});
+    };
+
+    _lanes[id] = std::move(l);
+
+    // Publish the lane for `submit()`
+    _lane_count.store(id + 1);
+
+    return stream;
+}
+
+bool encoder_pipeline::submit (int stream, float const * samples, std::size_t frames)
+{
+    if (stream < 0 || static_cast<std::size_t>(stream) >= _lane_count.load() || _stopped)
+        return false;
+
+    auto l = _lanes[stream].get();
+
+    auto tail = l->tail.load(std::memory_order_relaxed);
+    auto head = l->head.load(std::memory_order_acquire);
+
+    if (frames > _opts.max_frames || tail - head >= _opts.queue_capacity) {
+        l->rejected++;
+        return false;
+    }
+
+    auto & f = l->ring[tail % _opts.queue_capacity];
+    std::memcpy(f.samples.data(), samples
+        , frames * static_cast<std::size_t>(l->channels) * sizeof(float));
+    f.frames = frames;
+    f.pts = l->next_pts;
+    l->next_pts += frames;
+
+    l->tail.store(tail + 1);
+    l->submitted++;
+
+    // Only this thread updates the watermark
+    auto depth = tail + 1 - head;
+
+    if (depth > l->high_watermark.load(std::memory_order_relaxed))
+        l->high_watermark.store(depth, std::memory_order_relaxed);
+
+    if (!l->scheduled.exchange(true))
+        schedule(l, _next_worker++ % _workers.size());
+
+    return true;
+}
+
+// Called from the capture thread (by `submit()`): no locks, no allocations.
+void encoder_pipeline::schedule (lane * l, std::size_t worker_index)
+{
+    // Counted before the push, so that worker woken up by another lane
+    // does not exit on stop while this lane is being pushed
+    _queued.fetch_add(1);
+    _workers[worker_index]->queue.push(l);
+    _ready->signal();
+}
+
+encoder_pipeline::lane * encoder_pipeline::take (std::size_t worker_index)
+{
+    auto n = _workers.size();
+    lane * l = nullptr;
+
+    // Own queue first, then steal from other queues
+    for (std::size_t k = 0; k < n; k++) {
+        if (_workers[(worker_index + k) % n]->queue.pop(l)) {
+            _queued.fetch_sub(1);
+            return l;
+        }
+    }
+
+    return nullptr;
+}
+
+void encoder_pipeline::process (lane * l, std::size_t worker_index)
+{
+    for (std::size_t n = 0; n < _opts.batch; n++) {
+        auto head = l->head.load(std::memory_order_relaxed);
+
+        if (head == l->tail.load())
+            break;
+
+        auto & f = l->ring[head % _opts.queue_capacity];
+        l->enc->encode(f.samples.data(), f.frames, f.pts, l->emit);
+
+        l->head.store(head + 1, std::memory_order_release);
+        l->encoded++;
+    }
+
+    // More fragments queued: give other lanes a chance and come back later
+    if (l->head.load(std::memory_order_relaxed) != l->tail.load()) {
+        schedule(l, worker_index);
+        return;
+    }
+
+    l->scheduled.store(false);
+
+    // Producer could have queued a fragment after the check above but
+    // before the flag was cleared (and so skipped scheduling).
+    if (l->head.load(std::memory_order_relaxed) != l->tail.load()
+            && !l->scheduled.exchange(true)) {
+        schedule(l, worker_index);
+    }
+}
+
+void encoder_pipeline::run (std::size_t worker_index)
+{
+    while (true) {
+        // One semaphore unit per queued lane plus one per worker on stop
+        _ready->wait();
+
+        while (true) {
+            auto l = take(worker_index);
+
+            if (l) {
+                process(l, worker_index);
+                break;
+            }
+
+            if (_stopped.load() && _queued.load() == 0)
+                return;
+
+            // Lane is counted but its producer has not finished the push
+            // yet
+            std::this_thread::yield();
+        }
+    }
+}
+
+lane_stats encoder_pipeline::stats (int stream) const
+{
+    lane_stats result;
+
+    if (stream < 0 || static_cast<std::size_t>(stream) >= _lane_count.load())
+        return result;
+
+    auto l = _lanes[stream].get();
+
+    result.submitted = l->submitted.load();
+    result.encoded = l->encoded.load();
+    result.rejected = l->rejected.load();
+    result.queued = l->tail.load() - l->head.load();
+    result.high_watermark = l->high_watermark.load();
+
+    return result;
+}
+
+void encoder_pipeline::stop ()
+{
+    {
+        // Synchronize with `add_stream()`
+        std::lock_guard<std::mutex> locker{_lanes_mtx};
+
+        if (_stopped.exchange(true))
+            return;
+    }
+
+    _ready->signal(static_cast<int>(_workers.size()));
+
+    for (auto & w: _workers) {
+        if (w->thread.joinable())
+            w->thread.join();
+    }
+
+    auto count = _lane_count.load();
+
+    for (std::size_t i = 0; i < count; i++) {
+        auto l = _lanes[i].get();
+
+        if (l->enc)
+            l->enc->flush(l->emit);
+    }
+}
+
+}} // namespace multimedia::audio
@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "pfs/multimedia/error.hpp"
+#include <mutex>
+#include <vector>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+}
+
+namespace multimedia {
+
+inline error_code make_av_error (int rc)
+{
+    // POSIX errors are reported by FFmpeg as negated `errno` values,
+    // other errors are tags
+    if (rc < 0 && rc > -4096)
+        return error_code(-rc, std::generic_category());
+
+    return make_error_code(errc::backend_error);
+}
+
+// Pool of `AVPacket` structures passed between pipeline stages.
+class packet_pool final
+{
+    std::mutex _mtx;
+    std::vector<AVPacket *> _free;
+
+public:
+    ~packet_pool ()
+    {
+        for (auto p: _free)
+            av_packet_free(& p);
+    }
+
+    AVPacket * acquire ()
+    {
+        {
+            std::lock_guard<std::mutex> locker{_mtx};
+
+            if (!_free.empty()) {
+                auto p = _free.back();
+                _free.pop_back();
+                return p;
+            }
+        }
+
+        return av_packet_alloc();
+    }
+
+    void recycle (AVPacket * p)
+    {
+        if (!p)
+            return;
+
+        av_packet_unref(p);
+        std::lock_guard<std::mutex> locker{_mtx};
+        _free.push_back(p);
+    }
+};
+
+} // namespace multimedia
@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// References:
+//      1. Bounded MPMC queue, Dmitry Vyukov
+//         (https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue)
+//
+// Changelog:
+//      2026.10.19 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <atomic>
+#include <vector>
+#include <cstddef>
+
+namespace multimedia {
+
+// Lock-free multiple producers / multiple consumers queue of limited
+// capacity. Never blocks and does not allocate after construction.
+// Capacity is rounded up to the power of two.
+template <typename T>
+class mpmc_queue final
+{
+    struct cell
+    {
+        std::atomic<std::size_t> sequence;
+        T item;
+    };
+
+    std::vector<cell> _cells;
+    std::size_t _mask;
+    std::atomic<std::size_t> _head {0}; // Dequeue position
+    std::atomic<std::size_t> _tail {0}; // Enqueue position
+
+private:
+    static std::size_t round_capacity (std::size_t capacity)
+    {
+        std::size_t result = 2;
+
+        while (result < capacity)
+            result <<= 1;
+
+        return result;
+    }
+
+public:
+    explicit mpmc_queue (std::size_t capacity)
+        : _cells(round_capacity(capacity))
+        , _mask(_cells.size() - 1)
+    {
+        for (std::size_t i = 0; i < _cells.size(); i++)
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    mpmc_queue (mpmc_queue const &) = delete;
+    mpmc_queue & operator = (mpmc_queue const &) = delete;
+
+    std::size_t capacity () const noexcept
+    {
+        return _cells.size();
+    }
+
+    // Returns false if the queue is full.
+    bool push (T const & item)
+    {
+        auto pos = _tail.load(std::memory_order_relaxed);
+
+        while (true) {
+            auto & c = _cells[pos & _mask];
+            auto seq = c.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+
+            if (diff == 0) {
+                if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    c.item = item;
+                    c.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Returns false if the queue is empty (or the oldest item is still
+    // being written by a producer).
+    bool pop (T & item)
+    {
+        auto pos = _head.load(std::memory_order_relaxed);
+
+        while (true) {
+            auto & c = _cells[pos & _mask];
+            auto seq = c.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+
+            if (diff == 0) {
+                if (_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    item = c.item;
+                    c.sequence.store(pos + _mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+} // namespace multimedia
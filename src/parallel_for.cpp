@@ -0,0 +1,143 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "parallel_for.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace multimedia {
+
+namespace {
+
+// Lazily started pool of `hardware_concurrency - 1` workers shared by all
+// parallel loops of the library.
+class worker_pool final
+{
+    std::mutex _mtx;
+    std::condition_variable _cond;
+    std::deque<std::function<void ()>> _tasks;
+    std::vector<std::thread> _threads;
+    bool _stopped {false};
+
+public:
+    worker_pool ()
+    {
+        auto n = std::max(2u, std::thread::hardware_concurrency()) - 1;
+
+        for (unsigned int i = 0; i < n; i++) {
+            _threads.emplace_back([this] {
+                while (true) {
+                    std::function<void ()> task;
+
+                    {
+                        std::unique_lock<std::mutex> locker{_mtx};
+                        _cond.wait(locker, [this] { return _stopped || !_tasks.empty(); });
+
+                        if (_stopped && _tasks.empty())
+                            return;
+
+                        task = std::move(_tasks.front());
+                        _tasks.pop_front();
+                    }
+
+                    task();
+                }
+            });
+        }
+    }
+
+    ~worker_pool ()
+    {
+        {
+            std::lock_guard<std::mutex> locker{_mtx};
+            _stopped = true;
+        }
+
+        _cond.notify_all();
+
+        for (auto & t: _threads)
+            t.join();
+    }
+
+    std::size_t size () const noexcept
+    {
+        return _threads.size();
+    }
+
+    void post (std::function<void ()> task)
+    {
+        {
+            std::lock_guard<std::mutex> locker{_mtx};
+            _tasks.push_back(std::move(task));
+        }
+
+        _cond.notify_one();
+    }
+
+    static worker_pool & instance ()
+    {
+        static worker_pool pool;
+        return pool;
+    }
+};
+
+} // namespace
+
+std::size_t parallel_concurrency ()
+{
+    return worker_pool::instance().size() + 1;
+}
+
+void parallel_for (std::size_t count
+    , std::size_t parts
+    , std::function<void (std::size_t, std::size_t)> const & fn)
+{
+    if (count == 0)
+        return;
+
+    if (parts == 0)
+        parts = parallel_concurrency();
+
+    parts = std::min(parts, count);
+
+    if (parts <= 1) {
+        fn(0, count);
+        return;
+    }
+
+    std::mutex mtx;
+    std::condition_variable cond;
+    std::size_t remaining = parts - 1;
+    auto & pool = worker_pool::instance();
+
+    for (std::size_t i = 1; i < parts; i++) {
+        auto begin = count * i / parts;
+        auto end = count * (i + 1) / parts;
+
+        pool.post([& fn, & mtx, & cond, & remaining, begin, end] {
+            fn(begin, end);
+
+            std::lock_guard<std::mutex> locker{mtx};
+
+            if (--remaining == 0)
+                cond.notify_one();
+        });
+    }
+
+    // First chunk is processed by the calling thread
+    fn(0, count / parts);
+
+    std::unique_lock<std::mutex> locker{mtx};
+    cond.wait(locker, [& remaining] { return remaining == 0; });
+}
+
+} // namespace multimedia
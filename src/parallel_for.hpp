@@ -0,0 +1,26 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <functional>
+#include <cstddef>
+
+namespace multimedia {
+
+// Splits range [0, count) into `parts` contiguous chunks and processes them
+// in parallel on the shared worker pool (calling thread participates too).
+// Returns when all chunks are processed. `parts` equal to zero means number
+// of hardware threads.
+void parallel_for (std::size_t count
+    , std::size_t parts
+    , std::function<void (std::size_t, std::size_t)> const & fn);
+
+// Number of threads used by `parallel_for()` when `parts` is zero.
+std::size_t parallel_concurrency ();
+
+} // namespace multimedia
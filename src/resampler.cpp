@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/multimedia/resampler.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace multimedia {
+namespace audio {
+
+// Interpolation uses frames [i - 1, i + 2] around position `i + t`.
+static constexpr std::size_t HISTORY_FRAMES = 1;
+static constexpr std::size_t LOOKAHEAD_FRAMES = 2;
+
+fine_resampler::fine_resampler (int channels, double ratio)
+    : _channels(channels < 1 ? 1 : channels)
+{
+    set_ratio(ratio);
+    reset();
+}
+
+void fine_resampler::set_ratio (double ratio)
+{
+    if (ratio > 0)
+        _ratio = ratio;
+}
+
+void fine_resampler::reset ()
+{
+    _buffer.assign(HISTORY_FRAMES * _channels, 0.f);
+    _pos = static_cast<double>(HISTORY_FRAMES);
+}
+
+std::size_t fine_resampler::output_frames_max (std::size_t input_frames) const
+{
+    auto available = _buffer.size() / _channels + input_frames;
+    return static_cast<std::size_t>(std::ceil(static_cast<double>(available) * _ratio)) + 1;
+}
+
+std::size_t fine_resampler::process (float const * input
+    , std::size_t input_frames
+    , float * output)
+{
+    auto nchannels = static_cast<std::size_t>(_channels);
+
+    _buffer.insert(_buffer.end(), input, input + input_frames * nchannels);
+
+    auto frames = _buffer.size() / nchannels;
+    double step = 1.0 / _ratio;
+    float const * x = _buffer.data();
+    std::size_t produced = 0;
+
+    while (true) {
+        auto i = static_cast<std::size_t>(_pos);
+
+        if (i + LOOKAHEAD_FRAMES >= frames)
+            break;
+
+        auto t = static_cast<float>(_pos - static_cast<double>(i));
+        float const * p0 = x + (i - 1) * nchannels;
+        float const * p1 = p0 + nchannels;
+        float const * p2 = p1 + nchannels;
+        float const * p3 = p2 + nchannels;
+
+        for (std::size_t ch = 0; ch < nchannels; ch++) {
+            // Catmull-Rom spline
+            float c0 = p1[ch];
+            float c1 = 0.5f * (p2[ch] - p0[ch]);
+            float c2 = p0[ch] - 2.5f * p1[ch] + 2.f * p2[ch] - 0.5f * p3[ch];
+            float c3 = 0.5f * (p3[ch] - p0[ch]) + 1.5f * (p1[ch] - p2[ch]);
+            *output++ = ((c3 * t + c2) * t + c1) * t + c0;
+        }
+
+        produced++;
+        _pos += step;
+    }
+
+    // Discard consumed input keeping history for the next call
+    auto consumed = static_cast<std::size_t>(_pos) - HISTORY_FRAMES;
+
+    if (consumed > frames)
+        consumed = frames;
+
+    _buffer.erase(_buffer.begin(), _buffer.begin() + consumed * nchannels);
+    _pos -= static_cast<double>(consumed);
+
+    return produced;
+}
+
+}} // namespace multimedia::audio
@@ -0,0 +1,393 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Fixed jitter estimation on timestamp wraparound.
+//      2026.10.19 Only discarded packets are counted as dropped.
+//      2026.10.19 Added payload clock rate.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/multimedia/rtp.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace multimedia {
+namespace rtp {
+
+static constexpr std::uint8_t RTP_VERSION = 2;
+
+// True if sequence number `a` precedes `b` (RFC 3550 modular arithmetic).
+static inline bool sequence_before (std::uint16_t a, std::uint16_t b)
+{
+    return static_cast<std::int16_t>(static_cast<std::uint16_t>(a - b)) < 0;
+}
+
+static inline void write_u16 (std::uint8_t * p, std::uint16_t v)
+{
+    p[0] = static_cast<std::uint8_t>(v >> 8);
+    p[1] = static_cast<std::uint8_t>(v);
+}
+
+static inline void write_u32 (std::uint8_t * p, std::uint32_t v)
+{
+    p[0] = static_cast<std::uint8_t>(v >> 24);
+    p[1] = static_cast<std::uint8_t>(v >> 16);
+    p[2] = static_cast<std::uint8_t>(v >> 8);
+    p[3] = static_cast<std::uint8_t>(v);
+}
+
+static inline std::uint16_t read_u16 (std::uint8_t const * p)
+{
+    return static_cast<std::uint16_t>((p[0] << 8) | p[1]);
+}
+
+static inline std::uint32_t read_u32 (std::uint8_t const * p)
+{
+    return (static_cast<std::uint32_t>(p[0]) << 24)
+        | (static_cast<std::uint32_t>(p[1]) << 16)
+        | (static_cast<std::uint32_t>(p[2]) << 8)
+        | static_cast<std::uint32_t>(p[3]);
+}
+
+MULTIMEDIA__EXPORT std::uint32_t payload_clock_rate (std::uint8_t payload_type)
+{
+    switch (payload_type) {
+        case PAYLOAD_L16_STEREO:
+        case PAYLOAD_L16_MONO:
+            return 44100;
+        case PAYLOAD_OPUS:
+            return 48000;
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+MULTIMEDIA__EXPORT std::size_t serialize_header (header const & h, std::uint8_t * out)
+{
+    out[0] = RTP_VERSION << 6; // No padding, no extension, no CSRC
+    out[1] = static_cast<std::uint8_t>((h.marker ? 0x80 : 0) | (h.payload_type & 0x7F));
+    write_u16(out + 2, h.sequence);
+    write_u32(out + 4, h.timestamp);
+    write_u32(out + 8, h.ssrc);
+    return HEADER_SIZE;
+}
+
+MULTIMEDIA__EXPORT bool parse (std::uint8_t const * data
+    , std::size_t size
+    , header & h
+    , std::uint8_t const ** payload
+    , std::size_t * payload_size)
+{
+    if (size < HEADER_SIZE)
+        return false;
+
+    if ((data[0] >> 6) != RTP_VERSION)
+        return false;
+
+    bool padding   = (data[0] & 0x20) != 0;
+    bool extension = (data[0] & 0x10) != 0;
+    std::size_t csrc_count = data[0] & 0x0F;
+
+    h.marker = (data[1] & 0x80) != 0;
+    h.payload_type = data[1] & 0x7F;
+    h.sequence = read_u16(data + 2);
+    h.timestamp = read_u32(data + 4);
+    h.ssrc = read_u32(data + 8);
+
+    std::size_t offset = HEADER_SIZE + csrc_count * 4;
+
+    if (extension) {
+        if (offset + 4 > size)
+            return false;
+
+        std::size_t ext_words = read_u16(data + offset + 2);
+        offset += 4 + ext_words * 4;
+    }
+
+    if (offset > size)
+        return false;
+
+    std::size_t end = size;
+
+    if (padding) {
+        std::size_t padding_size = data[size - 1];
+
+        if (padding_size == 0 || offset + padding_size > size)
+            return false;
+
+        end -= padding_size;
+    }
+
+    *payload = data + offset;
+    *payload_size = end - offset;
+    return true;
+}
+
+MULTIMEDIA__EXPORT void encode_l16 (std::int16_t const * samples
+    , std::size_t count
+    , std::uint8_t * out)
+{
+    for (std::size_t i = 0; i < count; i++) {
+        auto v = static_cast<std::uint16_t>(samples[i]);
+        out[2 * i]     = static_cast<std::uint8_t>(v >> 8);
+        out[2 * i + 1] = static_cast<std::uint8_t>(v);
+    }
+}
+
+MULTIMEDIA__EXPORT void decode_l16 (std::uint8_t const * payload
+    , std::size_t count
+    , std::int16_t * samples)
+{
+    for (std::size_t i = 0; i < count; i++) {
+        samples[i] = static_cast<std::int16_t>(
+            (static_cast<std::uint16_t>(payload[2 * i]) << 8) | payload[2 * i + 1]);
+    }
+}
+
+MULTIMEDIA__EXPORT void conceal_l16 (std::int16_t * history
+    , std::size_t count
+    , float attenuation)
+{
+    for (std::size_t i = 0; i < count; i++)
+        history[i] = static_cast<std::int16_t>(static_cast<float>(history[i]) * attenuation);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// packetizer
+////////////////////////////////////////////////////////////////////////////////
+packetizer::packetizer (std::uint8_t payload_type
+    , std::uint32_t ssrc
+    , std::uint16_t initial_sequence
+    , std::uint32_t initial_timestamp)
+{
+    _header.payload_type = payload_type;
+    _header.ssrc = ssrc;
+    _header.sequence = initial_sequence;
+    _header.timestamp = initial_timestamp;
+}
+
+bool packetizer::pack (std::uint8_t const * payload
+    , std::size_t size
+    , std::uint32_t duration
+    , packet_buffer & out
+    , bool marker)
+{
+    if (HEADER_SIZE + size > PACKET_SIZE_MAX)
+        return false;
+
+    _header.marker = marker;
+    serialize_header(_header, out.data);
+    std::memcpy(out.data + HEADER_SIZE, payload, size);
+    out.size = HEADER_SIZE + size;
+
+    _header.sequence++;
+    _header.timestamp += duration;
+    return true;
+}
+
+bool packetizer::pack_l16 (std::int16_t const * samples
+    , std::size_t frames
+    , int channels
+    , packet_buffer & out
+    , bool marker)
+{
+    auto count = frames * static_cast<std::size_t>(channels);
+
+    if (HEADER_SIZE + count * 2 > PACKET_SIZE_MAX)
+        return false;
+
+    _header.marker = marker;
+    serialize_header(_header, out.data);
+    encode_l16(samples, count, out.data + HEADER_SIZE);
+    out.size = HEADER_SIZE + count * 2;
+
+    _header.sequence++;
+    _header.timestamp += static_cast<std::uint32_t>(frames);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// jitter_buffer
+////////////////////////////////////////////////////////////////////////////////
+jitter_buffer::jitter_buffer (jitter_buffer_options const & opts)
+    : _opts(opts)
+{
+    std::size_t capacity = 2;
+
+    while (capacity < _opts.capacity)
+        capacity <<= 1;
+
+    _opts.capacity = capacity;
+    _opts.max_packets = std::min(_opts.max_packets, capacity / 2);
+    _opts.min_packets = std::max<std::size_t>(1, std::min(_opts.min_packets, _opts.max_packets));
+
+    _slots.resize(capacity);
+    _mask = capacity - 1;
+}
+
+void jitter_buffer::reset ()
+{
+    for (auto & s: _slots)
+        s.occupied = false;
+
+    _playing = false;
+    _has_expected = false;
+    _buffered = 0;
+    _has_transit = false;
+    _last_transit = 0;
+    _stats = jitter_buffer_stats{};
+}
+
+std::size_t jitter_buffer::target_packets () const
+{
+    auto needed = static_cast<std::size_t>(std::ceil(_opts.jitter_factor
+        * _stats.jitter / static_cast<double>(_opts.packet_duration)));
+
+    return std::max(_opts.min_packets, std::min(_opts.max_packets, needed));
+}
+
+void jitter_buffer::push (header const & h
+    , std::uint8_t const * payload
+    , std::size_t size
+    , std::int64_t arrival_usec)
+{
+    _stats.received++;
+
+    // RFC 3550 A.8: interarrival jitter in timestamp units. Arrival time
+    // and transit are calculated modulo 2^32 as the timestamp itself, the
+    // difference of transits is small and signed.
+    auto arrival = static_cast<std::uint32_t>(arrival_usec
+        * static_cast<std::int64_t>(_opts.clock_rate) / 1000000);
+    std::uint32_t transit = arrival - h.timestamp;
+
+    if (_has_transit) {
+        auto d = static_cast<std::int32_t>(transit - _last_transit);
+        _stats.jitter += (std::fabs(static_cast<double>(d)) - _stats.jitter) / 16.0;
+    }
+
+    _has_transit = true;
+    _last_transit = transit;
+
+    if (size > PACKET_SIZE_MAX) {
+        _stats.dropped++;
+        return;
+    }
+
+    if (!_has_expected) {
+        _expected = h.sequence;
+        _has_expected = true;
+    } else if (sequence_before(h.sequence, _expected)) {
+        // Reordered packet arrived before playout started
+        if (!_playing && static_cast<std::uint16_t>(_expected - h.sequence) < _opts.max_packets) {
+            _expected = h.sequence;
+        } else {
+            _stats.late++;
+            return;
+        }
+    }
+
+    auto distance = static_cast<std::uint16_t>(h.sequence - _expected);
+
+    // Stream jumped forward (sender restart or long outage): start over
+    if (distance >= _opts.capacity) {
+        for (auto & s: _slots)
+            s.occupied = false;
+
+        _stats.dropped += _buffered;
+        _buffered = 0;
+        _expected = h.sequence;
+        _playing = false;
+    }
+
+    auto & s = _slots[h.sequence & _mask];
+
+    if (s.occupied) {
+        if (s.hdr.sequence == h.sequence) {
+            _stats.duplicated++;
+            return;
+        }
+
+        // Stale packet occupying the slot
+        _stats.dropped++;
+        _buffered--;
+    }
+
+    s.occupied = true;
+    s.hdr = h;
+    std::memcpy(s.payload.data, payload, size);
+    s.payload.size = size;
+    _buffered++;
+}
+
+bool jitter_buffer::push (packet_buffer const & packet, std::int64_t arrival_usec)
+{
+    header h;
+    std::uint8_t const * payload {nullptr};
+    std::size_t payload_size {0};
+
+    if (!parse(packet.data, packet.size, h, & payload, & payload_size))
+        return false;
+
+    push(h, payload, payload_size, arrival_usec);
+    return true;
+}
+
+playout_status jitter_buffer::pop (packet_buffer & out)
+{
+    auto target = target_packets();
+
+    if (!_playing) {
+        if (_buffered < target || _buffered == 0)
+            return playout_status::buffering;
+
+        _playing = true;
+    }
+
+    if (_buffered == 0) {
+        // Underrun: rebuffer up to target latency
+        _playing = false;
+        return playout_status::buffering;
+    }
+
+    // Too much latency accumulated (e.g. after a burst or jitter decrease):
+    // skip oldest packets. Skipped gaps are not counted: these packets were
+    // never received.
+    auto high_watermark = target + std::max<std::size_t>(2, target / 2);
+
+    while (_buffered > high_watermark) {
+        auto & s = _slots[_expected & _mask];
+
+        if (s.occupied && s.hdr.sequence == _expected) {
+            s.occupied = false;
+            _buffered--;
+            _stats.dropped++;
+        }
+
+        _expected++;
+    }
+
+    auto & s = _slots[_expected & _mask];
+    bool found = s.occupied && s.hdr.sequence == _expected;
+
+    _expected++;
+
+    if (!found) {
+        _stats.lost++;
+        return playout_status::lost;
+    }
+
+    std::memcpy(out.data, s.payload.data, s.payload.size);
+    out.size = s.payload.size;
+    s.occupied = false;
+    _buffered--;
+    _stats.played++;
+
+    return playout_status::ok;
+}
+
+}} // namespace multimedia::rtp
@@ -0,0 +1,285 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Socket creation error is reported, truncated datagrams are dropped.
+////////////////////////////////////////////////////////////////////////////////
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#   define _GNU_SOURCE // sendmmsg(), recvmmsg()
+#endif
+
+#include "pfs/multimedia/rtp.hpp"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace multimedia {
+namespace rtp {
+
+// Maximum number of packets passed to the kernel in one system call.
+static constexpr std::size_t BATCH_SIZE_MAX = 64;
+
+static inline error_code last_error ()
+{
+    return error_code(errno, std::generic_category());
+}
+
+static bool make_address (std::string const & addr
+    , std::uint16_t port
+    , sockaddr_in & sa
+    , error_code & ec)
+{
+    std::memset(& sa, 0, sizeof(sa));
+    sa.sin_family = AF_INET;
+    sa.sin_port = htons(port);
+
+    if (addr.empty()) {
+        sa.sin_addr.s_addr = htonl(INADDR_ANY);
+        return true;
+    }
+
+    if (inet_pton(AF_INET, addr.c_str(), & sa.sin_addr) != 1) {
+        ec = std::make_error_code(std::errc::invalid_argument);
+        return false;
+    }
+
+    return true;
+}
+
+udp_socket::udp_socket ()
+{
+    _fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+
+    if (_fd < 0)
+        _error = last_error();
+}
+
+udp_socket::~udp_socket ()
+{
+    close();
+}
+
+void udp_socket::close ()
+{
+    if (_fd >= 0) {
+        ::close(_fd);
+        _fd = -1;
+    }
+}
+
+bool udp_socket::check_valid (error_code & ec) const
+{
+    if (_fd >= 0)
+        return true;
+
+    // Closed socket or creation failure
+    ec = _error ? _error : std::make_error_code(std::errc::bad_file_descriptor);
+    return false;
+}
+
+bool udp_socket::bind (std::string const & addr, std::uint16_t port, error_code & ec)
+{
+    sockaddr_in sa;
+
+    if (!check_valid(ec))
+        return false;
+
+    if (!make_address(addr, port, sa, ec))
+        return false;
+
+    if (::bind(_fd, reinterpret_cast<sockaddr *>(& sa), sizeof(sa)) < 0) {
+        ec = last_error();
+        return false;
+    }
+
+    return true;
+}
+
+bool udp_socket::connect (std::string const & addr, std::uint16_t port, error_code & ec)
+{
+    sockaddr_in sa;
+
+    if (!check_valid(ec))
+        return false;
+
+    if (!make_address(addr, port, sa, ec))
+        return false;
+
+    if (::connect(_fd, reinterpret_cast<sockaddr *>(& sa), sizeof(sa)) < 0) {
+        ec = last_error();
+        return false;
+    }
+
+    return true;
+}
+
+int udp_socket::send (packet_buffer const * packets, std::size_t count, error_code & ec)
+{
+    std::size_t sent = 0;
+
+    if (!check_valid(ec))
+        return -1;
+
+#if defined(__linux__)
+    mmsghdr msgs[BATCH_SIZE_MAX];
+    iovec iovs[BATCH_SIZE_MAX];
+
+    while (sent < count) {
+        auto n = std::min(count - sent, BATCH_SIZE_MAX);
+
+        for (std::size_t i = 0; i < n; i++) {
+            iovs[i].iov_base = const_cast<std::uint8_t *>(packets[sent + i].data);
+            iovs[i].iov_len = packets[sent + i].size;
+            std::memset(& msgs[i].msg_hdr, 0, sizeof(msgs[i].msg_hdr));
+            msgs[i].msg_hdr.msg_iov = & iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        auto rc = ::sendmmsg(_fd, msgs, static_cast<unsigned int>(n), 0);
+
+        if (rc < 0) {
+            if (errno == EINTR)
+                continue;
+
+            ec = last_error();
+            return sent > 0 ? static_cast<int>(sent) : -1;
+        }
+
+        sent += static_cast<std::size_t>(rc);
+
+        // Partial send: socket buffer is full
+        if (static_cast<std::size_t>(rc) < n)
+            break;
+    }
+#else
+    while (sent < count) {
+        auto rc = ::send(_fd, packets[sent].data, packets[sent].size, 0);
+
+        if (rc < 0) {
+            if (errno == EINTR)
+                continue;
+
+            ec = last_error();
+            return sent > 0 ? static_cast<int>(sent) : -1;
+        }
+
+        sent++;
+    }
+#endif
+
+    return static_cast<int>(sent);
+}
+
+int udp_socket::receive (packet_buffer * packets
+    , std::size_t count
+    , int timeout_ms
+    , error_code & ec)
+{
+    if (!check_valid(ec))
+        return -1;
+
+    if (count == 0)
+        return 0;
+
+    pollfd pfd;
+    pfd.fd = _fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+
+    int rc = 0;
+
+    do {
+        rc = ::poll(& pfd, 1, timeout_ms);
+    } while (rc < 0 && errno == EINTR);
+
+    if (rc < 0) {
+        ec = last_error();
+        return -1;
+    }
+
+    if (rc == 0)
+        return 0;
+
+    std::size_t received = 0;
+
+#if defined(__linux__)
+    mmsghdr msgs[BATCH_SIZE_MAX];
+    iovec iovs[BATCH_SIZE_MAX];
+
+    auto n = std::min(count, BATCH_SIZE_MAX);
+
+    for (std::size_t i = 0; i < n; i++) {
+        iovs[i].iov_base = packets[i].data;
+        iovs[i].iov_len = PACKET_SIZE_MAX;
+        std::memset(& msgs[i].msg_hdr, 0, sizeof(msgs[i].msg_hdr));
+        msgs[i].msg_hdr.msg_iov = & iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    // Take everything already queued without blocking
+    rc = ::recvmmsg(_fd, msgs, static_cast<unsigned int>(n), MSG_DONTWAIT, nullptr);
+
+    if (rc < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+            return 0;
+
+        ec = last_error();
+        return -1;
+    }
+
+    // Truncated datagrams are dropped, the rest are moved into their place
+    for (std::size_t i = 0; i < static_cast<std::size_t>(rc); i++) {
+        if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) {
+            _truncated++;
+            continue;
+        }
+
+        if (received != i)
+            std::memcpy(packets[received].data, packets[i].data, msgs[i].msg_len);
+
+        packets[received].size = msgs[i].msg_len;
+        received++;
+    }
+#else
+    while (received < count) {
+        iovec iov;
+        iov.iov_base = packets[received].data;
+        iov.iov_len = PACKET_SIZE_MAX;
+
+        msghdr msg;
+        std::memset(& msg, 0, sizeof(msg));
+        msg.msg_iov = & iov;
+        msg.msg_iovlen = 1;
+
+        auto n = ::recvmsg(_fd, & msg, MSG_DONTWAIT);
+
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+                break;
+
+            ec = last_error();
+            return received > 0 ? static_cast<int>(received) : -1;
+        }
+
+        if (msg.msg_flags & MSG_TRUNC) {
+            _truncated++;
+            continue;
+        }
+
+        packets[received].size = static_cast<std::size_t>(n);
+        received++;
+    }
+#endif
+
+    return static_cast<int>(received);
+}
+
+}} // namespace multimedia::rtp
@@ -0,0 +1,127 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// References:
+//      1. Semaphores are Surprisingly Versatile, Jeff Preshing
+//         (https://preshing.com/20150316/semaphores-are-surprisingly-versatile/)
+//
+// Changelog:
+//      2026.10.19 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <atomic>
+
+#if defined(_WIN32)
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   ifndef WIN32_LEAN_AND_MEAN
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   include <windows.h>
+#elif defined(__linux__)
+#   include <semaphore.h>
+#   include <cerrno>
+#else
+#   include <condition_variable>
+#   include <mutex>
+#endif
+
+namespace multimedia {
+
+// Counting semaphore with the counter in user space: `signal()` is a single
+// atomic increment if nobody waits, and a non-blocking system call
+// (`sem_post()`, `ReleaseSemaphore()`) otherwise. So it is safe to signal
+// from a real-time (capture) thread.
+class semaphore final
+{
+    std::atomic<int> _count {0}; // Negative value is the number of waiters
+
+#if defined(_WIN32)
+    HANDLE _sem;
+
+    void os_wait ()
+    {
+        WaitForSingleObject(_sem, INFINITE);
+    }
+
+    void os_signal (int n)
+    {
+        ReleaseSemaphore(_sem, n, nullptr);
+    }
+#elif defined(__linux__)
+    sem_t _sem;
+
+    void os_wait ()
+    {
+        while (sem_wait(& _sem) != 0 && errno == EINTR)
+            ;
+    }
+
+    void os_signal (int n)
+    {
+        while (n-- > 0)
+            sem_post(& _sem);
+    }
+#else
+    // No lock-free wake up on other platforms
+    std::mutex _mtx;
+    std::condition_variable _cond;
+    int _os_count {0};
+
+    void os_wait ()
+    {
+        std::unique_lock<std::mutex> locker{_mtx};
+        _cond.wait(locker, [this] { return _os_count > 0; });
+        _os_count--;
+    }
+
+    void os_signal (int n)
+    {
+        std::lock_guard<std::mutex> locker{_mtx};
+        _os_count += n;
+        _cond.notify_all();
+    }
+#endif
+
+public:
+    semaphore ()
+    {
+#if defined(_WIN32)
+        _sem = CreateSemaphoreW(nullptr, 0, MAXLONG, nullptr);
+#elif defined(__linux__)
+        sem_init(& _sem, 0, 0);
+#endif
+    }
+
+    ~semaphore ()
+    {
+#if defined(_WIN32)
+        CloseHandle(_sem);
+#elif defined(__linux__)
+        sem_destroy(& _sem);
+#endif
+    }
+
+    semaphore (semaphore const &) = delete;
+    semaphore & operator = (semaphore const &) = delete;
+
+    void wait ()
+    {
+        if (_count.fetch_sub(1, std::memory_order_acquire) < 1)
+            os_wait();
+    }
+
+    void signal (int n = 1)
+    {
+        auto old = _count.fetch_add(n, std::memory_order_release);
+        auto waiters = old < 0 ? (-old < n ? -old : n) : 0;
+
+        if (waiters > 0)
+            os_signal(waiters);
+    }
+};
+
+} // namespace multimedia
@@ -0,0 +1,479 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Reader slots store owner process, slots of dead readers are reclaimed.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef _GNU_SOURCE
+#   define _GNU_SOURCE // memfd_create(), F_ADD_SEALS
+#endif
+
+#include "pfs/multimedia/shared_ring.hpp"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <cerrno>
+#include <cstring>
+
+namespace multimedia {
+namespace audio {
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Lock-free 64-bit atomics required for shared memory");
+
+static constexpr std::uint32_t SHARED_RING_MAGIC = 0x4D4D5352; // "MMSR"
+static constexpr std::uint32_t SHARED_RING_VERSION = 2;
+static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+struct reader_slot
+{
+    // Process identifier of the reader owning the slot, 0 if the slot is
+    // free. A reader killed before `close()` leaves the slot occupied,
+    // such slots are found by the owner process being gone.
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint32_t> owner;
+    std::atomic<std::uint64_t> cursor;
+};
+
+// Layout of the shared memory: header followed by the ring data. Writer
+// position counters and reader slots live on separate cache lines, so
+// readers publishing their cursors do not slow down the writer.
+struct shared_ring_header
+{
+    std::atomic<std::uint32_t> magic;
+    std::uint32_t version;
+    std::int32_t  channels;
+    std::int32_t  sample_rate;
+    std::uint64_t frame_bytes;
+    std::uint64_t capacity_frames;
+    std::uint64_t data_offset;
+
+    // Position up to which the writer is writing now (seqlock begin).
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> write_begin;
+
+    // Position up to which data is complete.
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint64_t> write_pos;
+
+    reader_slot readers[SHARED_RING_READERS_MAX];
+};
+
+static inline error_code last_error ()
+{
+    return error_code(errno, std::generic_category());
+}
+
+static inline std::size_t data_offset ()
+{
+    return (sizeof(shared_ring_header) + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+}
+
+// Frees the slot if its owner process does not exist anymore. `kill()`
+// with signal 0 checks the process existence only (EPERM means the process
+// exists but belongs to another user).
+static bool reclaim_dead_slot (reader_slot & slot)
+{
+    auto pid = slot.owner.load(std::memory_order_acquire);
+
+    if (pid == 0)
+        return false;
+
+    if (::kill(static_cast<pid_t>(pid), 0) == 0 || errno != ESRCH)
+        return false;
+
+    return slot.owner.compare_exchange_strong(pid, 0);
+}
+
+static shared_ring_info make_info (shared_ring_header const * h)
+{
+    shared_ring_info result;
+
+    if (h) {
+        result.channels = h->channels;
+        result.sample_rate = h->sample_rate;
+        result.frame_bytes = static_cast<std::size_t>(h->frame_bytes);
+        result.capacity_frames = static_cast<std::size_t>(h->capacity_frames);
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// shared_ring_writer
+////////////////////////////////////////////////////////////////////////////////
+shared_ring_writer::~shared_ring_writer ()
+{
+    close();
+}
+
+bool shared_ring_writer::create (std::string const & name
+    , int channels
+    , int sample_rate
+    , std::size_t frame_bytes
+    , std::size_t capacity_frames
+    , error_code & ec)
+{
+    close();
+
+    if (channels < 1 || frame_bytes == 0 || capacity_frames == 0) {
+        ec = std::make_error_code(std::errc::invalid_argument);
+        return false;
+    }
+
+    std::size_t capacity = 1;
+
+    while (capacity < capacity_frames)
+        capacity <<= 1;
+
+    _size = data_offset() + capacity * frame_bytes;
+    _fd = ::memfd_create(name.c_str(), MFD_CLOEXEC | MFD_ALLOW_SEALING);
+
+    if (_fd < 0) {
+        ec = last_error();
+        return false;
+    }
+
+    if (::ftruncate(_fd, static_cast<off_t>(_size)) < 0) {
+        ec = last_error();
+        close();
+        return false;
+    }
+
+    // Subscribers must not be able to resize the ring
+    ::fcntl(_fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL);
+
+    auto addr = ::mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+
+    if (addr == MAP_FAILED) {
+        ec = last_error();
+        close();
+        return false;
+    }
+
+    // Memory is zero filled by ftruncate()
+    _header = new (addr) shared_ring_header;
+    _header->version = SHARED_RING_VERSION;
+    _header->channels = channels;
+    _header->sample_rate = sample_rate;
+    _header->frame_bytes = frame_bytes;
+    _header->capacity_frames = capacity;
+    _header->data_offset = data_offset();
+    _header->write_begin.store(0, std::memory_order_relaxed);
+    _header->write_pos.store(0, std::memory_order_relaxed);
+
+    for (auto & slot: _header->readers) {
+        slot.owner.store(0, std::memory_order_relaxed);
+        slot.cursor.store(0, std::memory_order_relaxed);
+    }
+
+    _header->magic.store(SHARED_RING_MAGIC, std::memory_order_release);
+    _data = static_cast<std::uint8_t *>(addr) + data_offset();
+
+    return true;
+}
+
+void shared_ring_writer::write (void const * frames, std::size_t count)
+{
+    if (!_header || count == 0)
+        return;
+
+    auto capacity = static_cast<std::size_t>(_header->capacity_frames);
+    auto frame_bytes = static_cast<std::size_t>(_header->frame_bytes);
+    auto src = static_cast<std::uint8_t const *>(frames);
+    auto pos = _header->write_pos.load(std::memory_order_relaxed);
+
+    // Only the last `capacity` frames survive anyway
+    if (count > capacity) {
+        src += (count - capacity) * frame_bytes;
+        pos += count - capacity;
+        count = capacity;
+    }
+
+    auto end = pos + count;
+
+    _header->write_begin.store(end, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    auto offset = static_cast<std::size_t>(pos & (capacity - 1));
+    auto first = std::min(count, capacity - offset);
+
+    std::memcpy(_data + offset * frame_bytes, src, first * frame_bytes);
+
+    if (first < count)
+        std::memcpy(_data, src + first * frame_bytes, (count - first) * frame_bytes);
+
+    _header->write_pos.store(end, std::memory_order_release);
+}
+
+std::uint64_t shared_ring_writer::position () const
+{
+    return _header ? _header->write_pos.load(std::memory_order_relaxed) : 0;
+}
+
+std::size_t shared_ring_writer::readers () const
+{
+    std::size_t result = 0;
+
+    if (_header) {
+        for (auto const & slot: _header->readers) {
+            if (slot.owner.load(std::memory_order_relaxed))
+                result++;
+        }
+    }
+
+    return result;
+}
+
+std::size_t shared_ring_writer::reclaim_readers ()
+{
+    std::size_t result = 0;
+
+    if (_header) {
+        for (auto & slot: _header->readers) {
+            if (reclaim_dead_slot(slot))
+                result++;
+        }
+    }
+
+    return result;
+}
+
+std::size_t shared_ring_writer::lagging_readers (std::size_t threshold_frames) const
+{
+    std::size_t result = 0;
+
+    if (_header) {
+        auto pos = _header->write_pos.load(std::memory_order_relaxed);
+
+        for (auto const & slot: _header->readers) {
+            if (slot.owner.load(std::memory_order_acquire)
+                    && pos - slot.cursor.load(std::memory_order_relaxed) > threshold_frames) {
+                result++;
+            }
+        }
+    }
+
+    return result;
+}
+
+shared_ring_info shared_ring_writer::info () const
+{
+    return make_info(_header);
+}
+
+void shared_ring_writer::close ()
+{
+    if (_header) {
+        ::munmap(_header, _size);
+        _header = nullptr;
+        _data = nullptr;
+    }
+
+    if (_fd >= 0) {
+        ::close(_fd);
+        _fd = -1;
+    }
+
+    _size = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// shared_ring_reader
+////////////////////////////////////////////////////////////////////////////////
+shared_ring_reader::~shared_ring_reader ()
+{
+    close();
+}
+
+bool shared_ring_reader::attach (int fd, error_code & ec)
+{
+    _fd = fd;
+
+    struct stat st;
+
+    if (::fstat(_fd, & st) < 0) {
+        ec = last_error();
+        close();
+        return false;
+    }
+
+    _size = static_cast<std::size_t>(st.st_size);
+
+    if (_size < data_offset()) {
+        ec = std::make_error_code(std::errc::invalid_argument);
+        close();
+        return false;
+    }
+
+    // Mapped writable to publish own cursor in the reader slot
+    auto addr = ::mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+
+    if (addr == MAP_FAILED) {
+        ec = last_error();
+        close();
+        return false;
+    }
+
+    _header = static_cast<shared_ring_header *>(addr);
+
+    if (_header->magic.load(std::memory_order_acquire) != SHARED_RING_MAGIC
+            || _header->version != SHARED_RING_VERSION
+            || _header->data_offset + _header->capacity_frames * _header->frame_bytes > _size) {
+        ec = std::make_error_code(std::errc::invalid_argument);
+        close();
+        return false;
+    }
+
+    _data = static_cast<std::uint8_t const *>(addr) + _header->data_offset;
+    _cursor = _header->write_pos.load(std::memory_order_acquire);
+
+    auto pid = static_cast<std::uint32_t>(::getpid());
+
+    // Free slot first, then the slot of a dead reader
+    for (int pass = 0; pass < 2 && _slot < 0; pass++) {
+        for (std::size_t i = 0; i < SHARED_RING_READERS_MAX; i++) {
+            auto & slot = _header->readers[i];
+            std::uint32_t expected = 0;
+
+            if (pass > 0)
+                reclaim_dead_slot(slot);
+
+            if (slot.owner.compare_exchange_strong(expected, pid)) {
+                slot.cursor.store(_cursor, std::memory_order_relaxed);
+                _slot = static_cast<int>(i);
+                break;
+            }
+        }
+    }
+
+    if (_slot < 0) {
+        ec = std::make_error_code(std::errc::resource_unavailable_try_again);
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+bool shared_ring_reader::open (int fd, error_code & ec)
+{
+    close();
+
+    auto dupfd = ::fcntl(fd, F_DUPFD_CLOEXEC, 0);
+
+    if (dupfd < 0) {
+        ec = last_error();
+        return false;
+    }
+
+    return attach(dupfd, ec);
+}
+
+bool shared_ring_reader::open (int pid, int fd, error_code & ec)
+{
+    close();
+
+    auto path = std::string{"/proc/"} + std::to_string(pid) + "/fd/" + std::to_string(fd);
+    auto newfd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+
+    if (newfd < 0) {
+        ec = last_error();
+        return false;
+    }
+
+    return attach(newfd, ec);
+}
+
+std::size_t shared_ring_reader::available () const
+{
+    if (!_header)
+        return 0;
+
+    auto pos = _header->write_pos.load(std::memory_order_acquire);
+    return static_cast<std::size_t>(std::min<std::uint64_t>(pos - _cursor, _header->capacity_frames));
+}
+
+std::size_t shared_ring_reader::read (void * frames, std::size_t max_frames)
+{
+    if (!_header || max_frames == 0)
+        return 0;
+
+    auto capacity = static_cast<std::size_t>(_header->capacity_frames);
+    auto frame_bytes = static_cast<std::size_t>(_header->frame_bytes);
+    auto dest = static_cast<std::uint8_t *>(frames);
+    auto pos = _header->write_pos.load(std::memory_order_acquire);
+
+    // Fell behind more than the ring capacity: skip to the oldest frame
+    if (pos - _cursor > capacity) {
+        _lost_frames += pos - _cursor - capacity;
+        _overruns++;
+        _cursor = pos - capacity;
+    }
+
+    auto count = static_cast<std::size_t>(std::min<std::uint64_t>(pos - _cursor, max_frames));
+
+    if (count == 0)
+        return 0;
+
+    auto offset = static_cast<std::size_t>(_cursor & (capacity - 1));
+    auto first = std::min(count, capacity - offset);
+
+    std::memcpy(dest, _data + offset * frame_bytes, first * frame_bytes);
+
+    if (first < count)
+        std::memcpy(dest + first * frame_bytes, _data, (count - first) * frame_bytes);
+
+    // Validate copied frames: the writer may have overwritten the oldest
+    // of them while they were copied (seqlock read side).
+    std::atomic_thread_fence(std::memory_order_acquire);
+    auto begin = _header->write_begin.load(std::memory_order_relaxed);
+    auto oldest_valid = begin > capacity ? begin - capacity : 0;
+    std::size_t invalid = 0;
+
+    if (_cursor < oldest_valid) {
+        invalid = static_cast<std::size_t>(std::min<std::uint64_t>(oldest_valid - _cursor, count));
+        std::memmove(dest, dest + invalid * frame_bytes, (count - invalid) * frame_bytes);
+        _lost_frames += invalid;
+        _overruns++;
+    }
+
+    _cursor += count;
+    _header->readers[_slot].cursor.store(_cursor, std::memory_order_relaxed);
+
+    return count - invalid;
+}
+
+shared_ring_info shared_ring_reader::info () const
+{
+    return make_info(_header);
+}
+
+void shared_ring_reader::close ()
+{
+    if (_header) {
+        if (_slot >= 0)
+            _header->readers[_slot].owner.store(0, std::memory_order_release);
+
+        ::munmap(_header, _size);
+        _header = nullptr;
+        _data = nullptr;
+    }
+
+    if (_fd >= 0) {
+        ::close(_fd);
+        _fd = -1;
+    }
+
+    _slot = -1;
+    _size = 0;
+    _cursor = 0;
+    _lost_frames = 0;
+    _overruns = 0;
+}
+
+}} // namespace multimedia::audio
@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace multimedia {
+
+// Lock-free single producer / single consumer ring of trivially copyable
+// items. Never blocks and does not allocate after construction. Capacity
+// is rounded up to the power of two.
+template <typename T>
+class spsc_ring final
+{
+    std::vector<T> _items;
+    std::size_t _mask;
+    std::atomic<std::uint64_t> _head {0}; // Read position, owned by consumer
+    std::atomic<std::uint64_t> _tail {0}; // Write position, owned by producer
+
+private:
+    static std::size_t round_capacity (std::size_t capacity)
+    {
+        std::size_t result = 1;
+
+        while (result < capacity)
+            result <<= 1;
+
+        return result;
+    }
+
+public:
+    explicit spsc_ring (std::size_t capacity)
+        : _items(round_capacity(capacity))
+        , _mask(_items.size() - 1)
+    {}
+
+    std::size_t capacity () const noexcept
+    {
+        return _items.size();
+    }
+
+    // Number of items available for reading (consumer side).
+    std::size_t read_available () const noexcept
+    {
+        return static_cast<std::size_t>(_tail.load(std::memory_order_acquire)
+            - _head.load(std::memory_order_relaxed));
+    }
+
+    // Number of free slots (producer side).
+    std::size_t write_available () const noexcept
+    {
+        return _items.size() - static_cast<std::size_t>(_tail.load(std::memory_order_relaxed)
+            - _head.load(std::memory_order_acquire));
+    }
+
+    // Writes `count` items if there is enough room. Returns false otherwise.
+    bool push (T const * items, std::size_t count)
+    {
+        if (count > write_available())
+            return false;
+
+        auto tail = _tail.load(std::memory_order_relaxed);
+        auto index = static_cast<std::size_t>(tail) & _mask;
+        auto n = std::min(count, _items.size() - index);
+
+        std::copy(items, items + n, _items.begin() + index);
+        std::copy(items + n, items + count, _items.begin());
+
+        _tail.store(tail + count, std::memory_order_release);
+        return true;
+    }
+
+    // Reads up to `max_count` items into `items` (or discards them if
+    // `items` is `nullptr`). Returns number of items read.
+    std::size_t pop (T * items, std::size_t max_count)
+    {
+        auto count = std::min(max_count, read_available());
+        auto head = _head.load(std::memory_order_relaxed);
+
+        if (items) {
+            auto index = static_cast<std::size_t>(head) & _mask;
+            auto n = std::min(count, _items.size() - index);
+
+            std::copy(_items.begin() + index, _items.begin() + index + n, items);
+            std::copy(_items.begin(), _items.begin() + (count - n), items + n);
+        }
+
+        _head.store(head + count, std::memory_order_release);
+        return count;
+    }
+};
+
+} // namespace multimedia
@@ -0,0 +1,348 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Added spectral flux onset gate.
+//      2026.10.19 Pre-roll is flushed through `deliver()`.
+//      2026.10.19 Block is windowed before zero padding.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/multimedia/vad.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace multimedia {
+namespace audio {
+
+// Noise floor adaptation coefficients: floor follows energy decrease fast
+// and rises slowly by a constant factor per block (about 2 dB/s for 10 ms
+// blocks), so that continuous speech does not raise the floor to its level.
+static constexpr float NOISE_FLOOR_FALL = 0.25f;
+static constexpr float NOISE_FLOOR_RISE = 1.005f;
+
+// Lower bound of the noise floor to avoid division by zero on digital silence.
+static constexpr float NOISE_FLOOR_MIN = 1e-10f;
+
+static constexpr double PI = 3.14159265358979323846;
+
+static inline float from_db (float db)
+{
+    return std::pow(10.f, db / 10.f);
+}
+
+MULTIMEDIA__EXPORT void channel_energy (float const * samples
+    , std::size_t frames
+    , int channels
+    , float * energy)
+{
+    // Accumulate squares into a contiguous lane buffer whose length is
+    // a multiple of channels count. Inner loop has no stride and no
+    // dependencies between iterations, so it is vectorized by the compiler.
+    static constexpr std::size_t LANES_MAX = 64;
+
+    auto nchannels = static_cast<std::size_t>(channels);
+    std::size_t lanes = nchannels * std::max<std::size_t>(1, LANES_MAX / nchannels);
+    std::vector<float> heap_acc;
+    float stack_acc[LANES_MAX];
+    float * acc = stack_acc;
+
+    if (lanes > LANES_MAX) {
+        heap_acc.resize(lanes);
+        acc = heap_acc.data();
+    }
+
+    std::fill(acc, acc + lanes, 0.f);
+
+    std::size_t total = frames * nchannels;
+    std::size_t i = 0;
+
+    for (; i + lanes <= total; i += lanes) {
+        float const * p = samples + i;
+
+        for (std::size_t j = 0; j < lanes; j++)
+            acc[j] += p[j] * p[j];
+    }
+
+    // Tail (always a multiple of channels count)
+    for (std::size_t j = 0; i < total; i++, j++)
+        acc[j] += samples[i] * samples[i];
+
+    std::fill(energy, energy + nchannels, 0.f);
+
+    for (std::size_t j = 0; j < lanes; j++)
+        energy[j % nchannels] += acc[j];
+
+    if (frames > 0) {
+        for (std::size_t ch = 0; ch < nchannels; ch++)
+            energy[ch] /= static_cast<float>(frames);
+    }
+}
+
+voice_activity_detector::voice_activity_detector (vad_options const & opts, sink_type sink)
+    : _opts(opts)
+    , _sink(std::move(sink))
+{
+    if (_opts.channels < 1)
+        _opts.channels = 1;
+
+    if (_opts.block_frames < 1)
+        _opts.block_frames = 1;
+
+    if (_opts.hangover_blocks < 0)
+        _opts.hangover_blocks = 0;
+
+    // Silent blocks are delivered already if not dropped, so pre-roll is
+    // meaningless in this case.
+    if (_opts.preroll_blocks < 0 || !_opts.drop_silence)
+        _opts.preroll_blocks = 0;
+
+    auto block_samples = _opts.block_frames * static_cast<std::size_t>(_opts.channels);
+
+    _block.resize(block_samples);
+    _preroll.resize(block_samples * static_cast<std::size_t>(_opts.preroll_blocks));
+    _energy.resize(_opts.channels);
+    _noise_floor.resize(_opts.channels);
+
+    if (_opts.flux_threshold > 0.f) {
+        spectrum_options sopts;
+        sopts.fft_size = _opts.block_frames;
+        sopts.hop_size = _opts.block_frames;
+        // FFT size is rounded up to a power of two (e.g. 512 for 10 ms
+        // blocks at 48 kHz). Window must span the block only, so the block
+        // is windowed here and then zero padded up to the FFT size.
+        sopts.window = window_type::rectangular;
+
+        _spectrum.reset(new spectrum_analyzer{sopts});
+
+        _window.resize(_opts.block_frames);
+
+        for (std::size_t i = 0; i < _window.size(); i++) {
+            _window[i] = static_cast<float>(0.5 - 0.5 * std::cos(2 * PI
+                * static_cast<double>(i) / static_cast<double>(_window.size())));
+        }
+
+        _mix.resize(_spectrum->options().fft_size, 0.f);
+        _prev_magnitudes.resize(_spectrum->bins_count(), 0.f);
+        _prev_block.resize(block_samples);
+    }
+}
+
+voice_activity_detector::~voice_activity_detector () = default;
+
+void voice_activity_detector::reset ()
+{
+    _block_fill = 0;
+    _preroll_head = 0;
+    _preroll_count = 0;
+    _noise_floor_initialized = false;
+    _hangover = 0;
+    _flux = 0;
+    _prev_block_valid = false;
+}
+
+// Mixes channels of the block into windowed zero padded FFT input.
+void voice_activity_detector::mix (float const * block)
+{
+    auto nchannels = static_cast<std::size_t>(_opts.channels);
+    auto frames = _opts.block_frames;
+    float const * w = _window.data();
+    float * out = _mix.data();
+
+    if (nchannels == 1) {
+        for (std::size_t i = 0; i < frames; i++)
+            out[i] = block[i] * w[i];
+
+        return;
+    }
+
+    float const scale = 1.f / static_cast<float>(nchannels);
+
+    for (std::size_t i = 0; i < frames; i++, block += nchannels) {
+        float sum = 0;
+
+        for (std::size_t ch = 0; ch < nchannels; ch++)
+            sum += block[ch];
+
+        out[i] = sum * scale * w[i];
+    }
+}
+
+float voice_activity_detector::spectral_flux ()
+{
+    auto count = _prev_magnitudes.size();
+    float * prev = _prev_magnitudes.data();
+
+    if (_prev_block_valid) {
+        mix(_prev_block.data());
+        std::memcpy(prev, _spectrum->analyze(_mix.data()), count * sizeof(float));
+    } else {
+        std::fill(prev, prev + count, 0.f);
+    }
+
+    mix(_block.data());
+
+    float const * mag = _spectrum->analyze(_mix.data());
+    float rise = 0;
+    float total = 0;
+
+    for (std::size_t k = 0; k < count; k++) {
+        rise += std::max(mag[k] - prev[k], 0.f);
+        total += mag[k];
+    }
+
+    return total > 0.f ? rise / total : 0.f;
+}
+
+bool voice_activity_detector::detect ()
+{
+    channel_energy(_block.data(), _opts.block_frames, _opts.channels, _energy.data());
+
+    if (!_noise_floor_initialized) {
+        for (std::size_t ch = 0; ch < _energy.size(); ch++)
+            _noise_floor[ch] = std::max(_energy[ch], NOISE_FLOOR_MIN);
+
+        _noise_floor_initialized = true;
+    }
+
+    float const threshold = from_db(_opts.threshold_db);
+    float const absolute_floor = from_db(_opts.silence_floor_dbfs);
+    bool voiced = false;
+
+    for (std::size_t ch = 0; ch < _energy.size(); ch++) {
+        auto e = _energy[ch];
+        auto & nf = _noise_floor[ch];
+
+        if (e > absolute_floor && e > nf * threshold)
+            voiced = true;
+
+        if (e < nf)
+            nf += (e - nf) * NOISE_FLOOR_FALL;
+        else
+            nf = std::min(e, nf * NOISE_FLOOR_RISE);
+
+        nf = std::max(nf, NOISE_FLOOR_MIN);
+    }
+
+    // Spectral flux gates the onset only, so spectra (of this and of the
+    // previous block) are calculated for onset candidates only
+    if (_spectrum && voiced && _hangover == 0) {
+        _flux = spectral_flux();
+
+        if (_flux < _opts.flux_threshold)
+            voiced = false;
+    }
+
+    return voiced;
+}
+
+void voice_activity_detector::deliver (float const * samples, bool voiced)
+{
+    if (voiced)
+        _stats.blocks_voiced++;
+
+    if (!voiced && _opts.drop_silence) {
+        _stats.blocks_dropped++;
+        return;
+    }
+
+    if (_sink)
+        _sink(samples, _opts.block_frames, voiced);
+}
+
+void voice_activity_detector::process_block ()
+{
+    _stats.blocks_total++;
+
+    if (detect())
+        _hangover = _opts.hangover_blocks + 1;
+    else if (_hangover > 0)
+        _hangover--;
+
+    auto block_samples = _block.size();
+    auto preroll_capacity = static_cast<std::size_t>(_opts.preroll_blocks);
+
+    if (_hangover > 0) {
+        // Flush pre-roll (oldest first) marked as voiced: it is a part of
+        // the utterance now. These blocks were counted as dropped when
+        // buffered.
+        if (_preroll_count > 0) {
+            auto index = (_preroll_head + preroll_capacity - _preroll_count) % preroll_capacity;
+
+            for (std::size_t n = 0; n < _preroll_count; n++) {
+                _stats.blocks_dropped--;
+                deliver(& _preroll[index * block_samples], true);
+                index = (index + 1) % preroll_capacity;
+            }
+
+            _preroll_count = 0;
+        }
+
+        deliver(_block.data(), true);
+        return;
+    }
+
+    if (preroll_capacity > 0) {
+        std::memcpy(& _preroll[_preroll_head * block_samples]
+            , _block.data(), block_samples * sizeof(float));
+        _preroll_head = (_preroll_head + 1) % preroll_capacity;
+        _preroll_count = std::min(_preroll_count + 1, preroll_capacity);
+    }
+
+    deliver(_block.data(), false);
+
+    // Onset candidate always follows a silent block, keep it for the
+    // spectral flux
+    if (_spectrum) {
+        std::swap(_block, _prev_block);
+        _prev_block_valid = true;
+    }
+}
+
+void voice_activity_detector::process (float const * samples, std::size_t frames)
+{
+    auto nchannels = static_cast<std::size_t>(_opts.channels);
+
+    while (frames > 0) {
+        auto n = std::min(frames, _opts.block_frames - _block_fill);
+
+        std::memcpy(& _block[_block_fill * nchannels], samples, n * nchannels * sizeof(float));
+
+        _block_fill += n;
+        samples += n * nchannels;
+        frames -= n;
+
+        if (_block_fill == _opts.block_frames) {
+            process_block();
+            _block_fill = 0;
+        }
+    }
+}
+
+void voice_activity_detector::process (std::int16_t const * samples, std::size_t frames)
+{
+    static constexpr float SCALE = 1.f / 32768.f;
+    auto nchannels = static_cast<std::size_t>(_opts.channels);
+
+    while (frames > 0) {
+        auto n = std::min(frames, _opts.block_frames - _block_fill);
+        auto count = n * nchannels;
+        float * out = & _block[_block_fill * nchannels];
+
+        for (std::size_t i = 0; i < count; i++)
+            out[i] = static_cast<float>(samples[i]) * SCALE;
+
+        _block_fill += n;
+        samples += count;
+        frames -= n;
+
+        if (_block_fill == _opts.block_frames) {
+            process_block();
+            _block_fill = 0;
+        }
+    }
+}
+
+}} // namespace multimedia::audio
@@ -0,0 +1,624 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// References:
+//      1. ITU-R BT.601-7, ITU-R BT.709-6 (8-bit limited range integer
+//         approximations of the YCbCr <-> RGB matrices).
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 YUV <-> RGB kernels work on planar rows to vectorize.
+//      2026.10.19 Kernel row buffers do not allocate per call.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/multimedia/video.hpp"
+#include "parallel_for.hpp"
+#include <algorithm>
+#include <vector>
+#include <cstring>
+
+namespace multimedia {
+namespace video {
+
+// Frames with at least this number of pixels are converted in parallel
+// when number of threads is chosen automatically.
+static constexpr std::size_t PARALLEL_PIXELS_MIN = 640 * 480;
+
+// Kernel row buffers of frames up to this width are on the stack.
+static constexpr std::size_t SCRATCH_WIDTH_MAX = 4096;
+
+// Row buffers of a kernel call: stack storage of `N` bytes, larger buffers
+// of wider frames are per thread and grow once (kernels run on the pool
+// workers and the calling thread, never reentrantly).
+template <std::size_t N>
+class scratch_buffer
+{
+    std::uint8_t _stack[N];
+    std::uint8_t * _data;
+
+public:
+    explicit scratch_buffer (std::size_t size)
+        : _data(_stack)
+    {
+        if (size > N) {
+            thread_local std::vector<std::uint8_t> heap;
+
+            if (heap.size() < size)
+                heap.resize(size);
+
+            _data = heap.data();
+        }
+    }
+
+    scratch_buffer (scratch_buffer const &) = delete;
+    scratch_buffer & operator = (scratch_buffer const &) = delete;
+
+    std::uint8_t * data () noexcept
+    {
+        return _data;
+    }
+};
+
+// Fixed point (8 fractional bits) conversion coefficients.
+struct coefficients
+{
+    // YUV -> RGB
+    int ymul, rv, gu, gv, bu;
+
+    // RGB -> YUV
+    int yr, yg, yb;
+    int ur, ug, ub;
+    int vr, vg, vb;
+};
+
+static constexpr coefficients BT601 {
+      298, 409, 100, 208, 516
+    , 66, 129, 25
+    , -38, -74, 112
+    , 112, -94, -18
+};
+
+static constexpr coefficients BT709 {
+      298, 459, 55, 136, 541
+    , 47, 157, 16
+    , -26, -87, 112
+    , 112, -102, -10
+};
+
+// Format traits. Samples of the YUV formats are addressed by compile time
+// steps, so the same kernels serve planar, semi-planar and packed layouts.
+struct i420_tag  { enum { is_rgb = 0, ystep = 1, cstep = 1, c422 = 0 }; };
+struct nv12_tag  { enum { is_rgb = 0, ystep = 1, cstep = 2, c422 = 0 }; };
+struct yuyv_tag  { enum { is_rgb = 0, ystep = 2, cstep = 4, c422 = 1 }; };
+struct rgb24_tag { enum { is_rgb = 1, bpp = 3 }; };
+struct rgba_tag  { enum { is_rgb = 1, bpp = 4 }; };
+
+struct yuv_view
+{
+    std::uint8_t * y;
+    std::uint8_t * u;
+    std::uint8_t * v;
+    std::size_t ystride;
+    std::size_t cstride;
+};
+
+struct rgb_view
+{
+    std::uint8_t * data;
+    std::size_t stride;
+};
+
+static yuv_view make_yuv_view (frame const & f)
+{
+    auto & ff = const_cast<frame &>(f);
+    yuv_view result;
+
+    switch (f.format()) {
+        case pixel_format::i420:
+            result.y = ff.data(0);
+            result.u = ff.data(1);
+            result.v = ff.data(2);
+            result.ystride = f.stride(0);
+            result.cstride = f.stride(1);
+            break;
+
+        case pixel_format::nv12:
+            result.y = ff.data(0);
+            result.u = ff.data(1);
+            result.v = ff.data(1) + 1;
+            result.ystride = f.stride(0);
+            result.cstride = f.stride(1);
+            break;
+
+        case pixel_format::yuyv:
+        default:
+            result.y = ff.data(0);
+            result.u = ff.data(0) + 1;
+            result.v = ff.data(0) + 3;
+            result.ystride = f.stride(0);
+            result.cstride = f.stride(0);
+            break;
+    }
+
+    return result;
+}
+
+static rgb_view make_rgb_view (frame const & f)
+{
+    return rgb_view{const_cast<frame &>(f).data(0), f.stride(0)};
+}
+
+static inline std::uint8_t clamp8 (int v)
+{
+    return static_cast<std::uint8_t>(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+struct context
+{
+    frame const * src;
+    frame * dst;
+    coefficients const * k;
+    int width;
+    int height;
+};
+
+// Kernels process range of row pairs [p0, p1): rows 2p and 2p + 1 share
+// chroma row of 4:2:0 formats.
+template <typename S, typename D, bool SrcRgb = S::is_rgb, bool DstRgb = D::is_rgb>
+struct kernel;
+
+// YUV -> YUV
+template <typename S, typename D>
+struct kernel<S, D, false, false>
+{
+    static void run (context const & ctx, std::size_t p0, std::size_t p1)
+    {
+        auto src = make_yuv_view(*ctx.src);
+        auto dst = make_yuv_view(*ctx.dst);
+        int w = ctx.width;
+        int h = ctx.height;
+        int cw = (w + 1) / 2;
+
+        for (auto p = p0; p < p1; p++) {
+            int y0 = static_cast<int>(2 * p);
+            int y1 = std::min(y0 + 1, h - 1);
+
+            for (int y = y0; y <= y0 + 1 && y < h; y++) {
+                std::uint8_t const * sy = src.y + y * src.ystride;
+                std::uint8_t * dy = dst.y + y * dst.ystride;
+
+                for (int x = 0; x < w; x++)
+                    dy[x * D::ystep] = sy[x * S::ystep];
+
+                if (D::c422) {
+                    auto srow = static_cast<std::size_t>(S::c422 ? y : static_cast<int>(p));
+                    std::uint8_t const * su = src.u + srow * src.cstride;
+                    std::uint8_t const * sv = src.v + srow * src.cstride;
+                    std::uint8_t * du = dst.u + y * dst.cstride;
+                    std::uint8_t * dv = dst.v + y * dst.cstride;
+
+                    for (int c = 0; c < cw; c++) {
+                        du[c * D::cstep] = su[c * S::cstep];
+                        dv[c * D::cstep] = sv[c * S::cstep];
+                    }
+                }
+            }
+
+            if (!D::c422) {
+                std::uint8_t * du = dst.u + p * dst.cstride;
+                std::uint8_t * dv = dst.v + p * dst.cstride;
+
+                if (S::c422) {
+                    // Vertical 2:1 chroma decimation
+                    std::uint8_t const * su0 = src.u + y0 * src.cstride;
+                    std::uint8_t const * sv0 = src.v + y0 * src.cstride;
+                    std::uint8_t const * su1 = src.u + y1 * src.cstride;
+                    std::uint8_t const * sv1 = src.v + y1 * src.cstride;
+
+                    for (int c = 0; c < cw; c++) {
+                        du[c * D::cstep] = static_cast<std::uint8_t>((su0[c * S::cstep] + su1[c * S::cstep] + 1) >> 1);
+                        dv[c * D::cstep] = static_cast<std::uint8_t>((sv0[c * S::cstep] + sv1[c * S::cstep] + 1) >> 1);
+                    }
+                } else {
+                    std::uint8_t const * su = src.u + p * src.cstride;
+                    std::uint8_t const * sv = src.v + p * src.cstride;
+
+                    for (int c = 0; c < cw; c++) {
+                        du[c * D::cstep] = su[c * S::cstep];
+                        dv[c * D::cstep] = sv[c * S::cstep];
+                    }
+                }
+            }
+        }
+    }
+};
+
+// Row kernels of YUV <-> RGB conversion. Arithmetic is done on planar
+// rows of R, G, B samples with constant step loads and stores only, rows
+// are declared `__restrict` (distinct memory), so that the loops are
+// vectorized for SSE2 and NEON. Packed RGB rows are (de)interleaved by
+// separate loops (vectorized for RGBA, and for RGB24 with SSSE3 or NEON).
+// Coefficients are passed by value: stores into `std::uint8_t` rows may
+// alias anything, members referenced through a pointer would be reloaded
+// in every iteration.
+
+template <int Bpp>
+static void unpack_rgb (std::uint8_t const * __restrict in
+    , std::uint8_t * __restrict r
+    , std::uint8_t * __restrict g
+    , std::uint8_t * __restrict b
+    , int w)
+{
+    for (int x = 0; x < w; x++) {
+        r[x] = in[x * Bpp + 0];
+        g[x] = in[x * Bpp + 1];
+        b[x] = in[x * Bpp + 2];
+    }
+}
+
+// Alpha is taken from the row `a` too (RGBA only): stores of the constant
+// alpha mixed with the interleaved samples are not vectorized.
+template <int Bpp>
+static void pack_rgb (std::uint8_t const * __restrict r
+    , std::uint8_t const * __restrict g
+    , std::uint8_t const * __restrict b
+    , std::uint8_t const * __restrict a
+    , std::uint8_t * __restrict out
+    , int w)
+{
+    for (int x = 0; x < w; x++) {
+        out[x * Bpp + 0] = r[x];
+        out[x * Bpp + 1] = g[x];
+        out[x * Bpp + 2] = b[x];
+
+        if (Bpp == 4)
+            out[x * Bpp + 3] = a[x];
+    }
+}
+
+// Converts `pairs` pairs of pixels sharing chroma samples.
+template <int YStep, int CStep>
+static void yuv_to_rgb_row (std::uint8_t const * __restrict sy
+    , std::uint8_t const * __restrict su
+    , std::uint8_t const * __restrict sv
+    , std::uint8_t * __restrict r
+    , std::uint8_t * __restrict g
+    , std::uint8_t * __restrict b
+    , int pairs
+    , coefficients k)
+{
+    int const ymul = k.ymul;
+    int const rv = k.rv;
+    int const gu = k.gu;
+    int const gv = k.gv;
+    int const bu = k.bu;
+
+    for (int c = 0; c < pairs; c++) {
+        int u = su[c * CStep] - 128;
+        int v = sv[c * CStep] - 128;
+        int dr = rv * v + 128;
+        int dg = 128 - gu * u - gv * v;
+        int db = bu * u + 128;
+        int y0 = ymul * (sy[2 * c * YStep] - 16);
+        int y1 = ymul * (sy[(2 * c + 1) * YStep] - 16);
+
+        r[2 * c] = clamp8((y0 + dr) >> 8);
+        g[2 * c] = clamp8((y0 + dg) >> 8);
+        b[2 * c] = clamp8((y0 + db) >> 8);
+        r[2 * c + 1] = clamp8((y1 + dr) >> 8);
+        g[2 * c + 1] = clamp8((y1 + dg) >> 8);
+        b[2 * c + 1] = clamp8((y1 + db) >> 8);
+    }
+}
+
+static void rgb_to_luma_row (std::uint8_t const * __restrict r
+    , std::uint8_t const * __restrict g
+    , std::uint8_t const * __restrict b
+    , std::uint8_t * __restrict dy
+    , int w
+    , coefficients k)
+{
+    int const yr = k.yr;
+    int const yg = k.yg;
+    int const yb = k.yb;
+
+    for (int x = 0; x < w; x++)
+        dy[x] = clamp8(((yr * r[x] + yg * g[x] + yb * b[x] + 128) >> 8) + 16);
+}
+
+// Chroma of 2x2 blocks of rows `a` and `b` (the same row for 4:2:2).
+static void rgb_to_chroma_row (std::uint8_t const * __restrict ra
+    , std::uint8_t const * __restrict ga
+    , std::uint8_t const * __restrict ba
+    , std::uint8_t const * __restrict rb
+    , std::uint8_t const * __restrict gb
+    , std::uint8_t const * __restrict bb
+    , std::uint8_t * __restrict du
+    , std::uint8_t * __restrict dv
+    , int pairs
+    , coefficients k)
+{
+    int const ur = k.ur;
+    int const ug = k.ug;
+    int const ub = k.ub;
+    int const vr = k.vr;
+    int const vg = k.vg;
+    int const vb = k.vb;
+
+    for (int c = 0; c < pairs; c++) {
+        int r = ra[2 * c] + ra[2 * c + 1] + rb[2 * c] + rb[2 * c + 1];
+        int g = ga[2 * c] + ga[2 * c + 1] + gb[2 * c] + gb[2 * c + 1];
+        int b = ba[2 * c] + ba[2 * c + 1] + bb[2 * c] + bb[2 * c + 1];
+
+        // Sums of four pixels: two more fractional bits
+        du[c] = clamp8(((ur * r + ug * g + ub * b + 512) >> 10) + 128);
+        dv[c] = clamp8(((vr * r + vg * g + vb * b + 512) >> 10) + 128);
+    }
+}
+
+// Interleaves chroma rows into NV12 UV row.
+static void pack_uv (std::uint8_t const * __restrict u
+    , std::uint8_t const * __restrict v
+    , std::uint8_t * __restrict out
+    , int pairs)
+{
+    for (int c = 0; c < pairs; c++) {
+        out[2 * c] = u[c];
+        out[2 * c + 1] = v[c];
+    }
+}
+
+static void pack_yuyv (std::uint8_t const * __restrict y
+    , std::uint8_t const * __restrict u
+    , std::uint8_t const * __restrict v
+    , std::uint8_t * __restrict out
+    , int pairs)
+{
+    for (int c = 0; c < pairs; c++) {
+        out[4 * c + 0] = y[2 * c];
+        out[4 * c + 1] = u[c];
+        out[4 * c + 2] = y[2 * c + 1];
+        out[4 * c + 3] = v[c];
+    }
+}
+
+// YUV -> RGB
+template <typename S, typename D>
+struct kernel<S, D, false, true>
+{
+    static void run (context const & ctx, std::size_t p0, std::size_t p1)
+    {
+        auto src = make_yuv_view(*ctx.src);
+        auto dst = make_rgb_view(*ctx.dst);
+        auto k = *ctx.k;
+        int w = ctx.width;
+        int h = ctx.height;
+        auto n = static_cast<std::size_t>(w + 1);
+
+        // Planar R, G, B row (one extra sample for odd width) and opaque
+        // alpha row
+        scratch_buffer<4 * (SCRATCH_WIDTH_MAX + 1)> planes {4 * n};
+        std::uint8_t * r = planes.data();
+        std::uint8_t * g = r + n;
+        std::uint8_t * b = g + n;
+        std::uint8_t * a = b + n;
+
+        std::memset(a, 255, n);
+
+        for (auto p = p0; p < p1; p++) {
+            int y0 = static_cast<int>(2 * p);
+
+            for (int y = y0; y <= y0 + 1 && y < h; y++) {
+                auto crow = static_cast<std::size_t>(S::c422 ? y : static_cast<int>(p));
+                std::uint8_t const * sy = src.y + y * src.ystride;
+                std::uint8_t const * su = src.u + crow * src.cstride;
+                std::uint8_t const * sv = src.v + crow * src.cstride;
+
+                yuv_to_rgb_row<S::ystep, S::cstep>(sy, su, sv, r, g, b, w / 2, k);
+
+                if (w & 1) {
+                    // Last pixel makes a pair with itself
+                    int c = w / 2;
+                    std::uint8_t last[2 * S::ystep];
+                    last[0] = last[S::ystep] = sy[(w - 1) * S::ystep];
+
+                    yuv_to_rgb_row<S::ystep, S::cstep>(last, su + c * S::cstep
+                        , sv + c * S::cstep, r + w - 1, g + w - 1, b + w - 1, 1, k);
+                }
+
+                pack_rgb<D::bpp>(r, g, b, a, dst.data + y * dst.stride, w);
+            }
+        }
+    }
+};
+
+// RGB -> YUV
+template <typename S, typename D>
+struct kernel<S, D, true, false>
+{
+    static void run (context const & ctx, std::size_t p0, std::size_t p1)
+    {
+        auto src = make_rgb_view(*ctx.src);
+        auto dst = make_yuv_view(*ctx.dst);
+        auto k = *ctx.k;
+        int w = ctx.width;
+        int h = ctx.height;
+        int cw = (w + 1) / 2;
+        auto n = static_cast<std::size_t>(2 * cw);
+
+        // Planar R, G, B of two rows (last pixel of odd width is
+        // duplicated), luma and chroma rows of packed formats
+        scratch_buffer<8 * (SCRATCH_WIDTH_MAX + 1)> planes {8 * n};
+        std::uint8_t * rgb[2][3];
+
+        for (int i = 0; i < 6; i++)
+            rgb[i / 3][i % 3] = planes.data() + static_cast<std::size_t>(i) * n;
+
+        std::uint8_t * ly = planes.data() + 6 * n;
+        std::uint8_t * cu = ly + n;
+        std::uint8_t * cv = cu + cw;
+
+        for (auto p = p0; p < p1; p++) {
+            int y0 = static_cast<int>(2 * p);
+            int rows = std::min(2, h - y0);
+
+            for (int i = 0; i < rows; i++) {
+                std::uint8_t * const * pl = rgb[i];
+                unpack_rgb<S::bpp>(src.data + (y0 + i) * src.stride, pl[0], pl[1], pl[2], w);
+
+                if (w & 1) {
+                    for (int j = 0; j < 3; j++)
+                        pl[j][w] = pl[j][w - 1];
+                }
+            }
+
+            for (int i = 0; i < rows; i++) {
+                std::uint8_t * const * pl = rgb[i];
+                std::uint8_t * dy = dst.y + (y0 + i) * dst.ystride;
+
+                if (D::ystep == 1) {
+                    rgb_to_luma_row(pl[0], pl[1], pl[2], dy, w, k);
+                } else {
+                    // Packed 4:2:2: chroma of the row itself
+                    rgb_to_luma_row(pl[0], pl[1], pl[2], ly, 2 * cw, k);
+                    rgb_to_chroma_row(pl[0], pl[1], pl[2], pl[0], pl[1], pl[2], cu, cv, cw, k);
+                    pack_yuyv(ly, cu, cv, dy, cw);
+                }
+            }
+
+            if (!D::c422) {
+                // Chroma of the 2x2 blocks (the last row of odd height
+                // makes a block with itself)
+                std::uint8_t * const * pa = rgb[0];
+                std::uint8_t * const * pb = rgb[rows - 1];
+                std::uint8_t * du = dst.u + p * dst.cstride;
+                std::uint8_t * dv = dst.v + p * dst.cstride;
+
+                if (D::cstep == 1) {
+                    rgb_to_chroma_row(pa[0], pa[1], pa[2], pb[0], pb[1], pb[2], du, dv, cw, k);
+                } else {
+                    rgb_to_chroma_row(pa[0], pa[1], pa[2], pb[0], pb[1], pb[2], cu, cv, cw, k);
+                    pack_uv(cu, cv, du, cw);
+                }
+            }
+        }
+    }
+};
+
+// RGB -> RGB
+template <typename S, typename D>
+struct kernel<S, D, true, true>
+{
+    static void run (context const & ctx, std::size_t p0, std::size_t p1)
+    {
+        auto src = make_rgb_view(*ctx.src);
+        auto dst = make_rgb_view(*ctx.dst);
+        int w = ctx.width;
+        int h = ctx.height;
+
+        for (auto p = p0; p < p1; p++) {
+            int y0 = static_cast<int>(2 * p);
+
+            for (int y = y0; y <= y0 + 1 && y < h; y++) {
+                std::uint8_t const * in = src.data + y * src.stride;
+                std::uint8_t * out = dst.data + y * dst.stride;
+
+                for (int x = 0; x < w; x++) {
+                    out[x * D::bpp + 0] = in[x * S::bpp + 0];
+                    out[x * D::bpp + 1] = in[x * S::bpp + 1];
+                    out[x * D::bpp + 2] = in[x * S::bpp + 2];
+
+                    if (D::bpp == 4)
+                        out[x * D::bpp + 3] = S::bpp == 4 ? in[x * S::bpp + 3] : 255;
+                }
+            }
+        }
+    }
+};
+
+using kernel_fn = void (*) (context const &, std::size_t, std::size_t);
+
+template <typename S>
+static kernel_fn select_kernel (pixel_format dst)
+{
+    switch (dst) {
+        case pixel_format::i420:  return & kernel<S, i420_tag>::run;
+        case pixel_format::nv12:  return & kernel<S, nv12_tag>::run;
+        case pixel_format::yuyv:  return & kernel<S, yuyv_tag>::run;
+        case pixel_format::rgb24: return & kernel<S, rgb24_tag>::run;
+        case pixel_format::rgba:  return & kernel<S, rgba_tag>::run;
+    }
+
+    return nullptr;
+}
+
+static kernel_fn select_kernel (pixel_format src, pixel_format dst)
+{
+    switch (src) {
+        case pixel_format::i420:  return select_kernel<i420_tag>(dst);
+        case pixel_format::nv12:  return select_kernel<nv12_tag>(dst);
+        case pixel_format::yuyv:  return select_kernel<yuyv_tag>(dst);
+        case pixel_format::rgb24: return select_kernel<rgb24_tag>(dst);
+        case pixel_format::rgba:  return select_kernel<rgba_tag>(dst);
+    }
+
+    return nullptr;
+}
+
+static void copy_planes (frame const & src, frame & dst)
+{
+    for (int i = 0; i < src.planes_count(); i++) {
+        auto row_bytes = src.plane_row_bytes(i);
+        auto rows = src.plane_height(i);
+
+        for (int r = 0; r < rows; r++) {
+            std::memcpy(dst.data(i) + r * dst.stride(i)
+                , src.data(i) + r * src.stride(i)
+                , row_bytes);
+        }
+    }
+}
+
+MULTIMEDIA__EXPORT bool convert (frame const & src
+    , frame & dst
+    , color_space cs
+    , std::size_t threads)
+{
+    if (src.empty() || dst.empty())
+        return false;
+
+    if (src.width() != dst.width() || src.height() != dst.height())
+        return false;
+
+    if (src.format() == dst.format()) {
+        copy_planes(src, dst);
+        return true;
+    }
+
+    auto fn = select_kernel(src.format(), dst.format());
+
+    if (!fn)
+        return false;
+
+    context ctx;
+    ctx.src = & src;
+    ctx.dst = & dst;
+    ctx.k = cs == color_space::bt709 ? & BT709 : & BT601;
+    ctx.width = src.width();
+    ctx.height = src.height();
+
+    auto pairs = static_cast<std::size_t>((src.height() + 1) / 2);
+    auto pixels = static_cast<std::size_t>(src.width()) * static_cast<std::size_t>(src.height());
+
+    if (threads == 0 && pixels < PARALLEL_PIXELS_MIN)
+        threads = 1;
+
+    parallel_for(pairs, threads, [fn, & ctx] (std::size_t p0, std::size_t p1) {
+        fn(ctx, p0, p1);
+    });
+
+    return true;
+}
+
+}} // namespace multimedia::video
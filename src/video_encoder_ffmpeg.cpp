@@ -0,0 +1,525 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// References:
+//      1. Encode video frame by frame in C++ using FFmpeg
+//         (https://github.com/apc-llc/moviemaker-cpp)
+//      2. FFmpeg Wiki - H.264 Video Encoding Guide
+//         (https://trac.ffmpeg.org/wiki/Encode/H.264)
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Conversion failure stops the pipeline.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/multimedia/video_encoder.hpp"
+#include "bounded_queue.hpp"
+#include "ffmpeg_utils.hpp"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/avutil.h>
+}
+
+namespace multimedia {
+namespace video {
+
+namespace {
+
+struct frame_item
+{
+    frame f;
+    std::int64_t pts {0};
+    bool eos {false};
+};
+
+struct packet_item
+{
+    AVPacket * pkt {nullptr};
+    bool eos {false};
+};
+
+// Releases frame buffer referenced by `AVBufferRef` (see `wrap()`).
+void release_frame (void * opaque, std::uint8_t *)
+{
+    delete static_cast<frame *>(opaque);
+}
+
+} // namespace
+
+class encoder::impl
+{
+public:
+    encoder_options opts;
+    packet_callback callback;
+
+    AVFormatContext * format {nullptr};
+    AVStream * stream {nullptr};
+    AVCodecContext * codec {nullptr};
+    AVFrame * wrapper {nullptr};
+
+    frame_pool converted_frames;
+    packet_pool packet_store;
+
+    bounded_queue<frame_item> input;
+    bounded_queue<frame_item> converted;
+    bounded_queue<packet_item> output;
+
+    std::thread convert_thread;
+    std::thread encode_thread;
+    std::thread mux_thread;
+
+    std::int64_t next_pts {0};
+    std::atomic<std::size_t> packets {0};
+    std::atomic<bool> failed {false};
+    bool finished {false};
+    std::mutex error_mtx;
+    error_code error;
+
+public:
+    impl (encoder_options const & o)
+        : opts(o)
+        , converted_frames(pixel_format::i420, o.width, o.height, 2 * o.queue_size)
+        , input(o.queue_size)
+        , converted(o.queue_size)
+        , output(4 * o.queue_size)
+    {}
+
+    ~impl ()
+    {
+        abort();
+        join();
+
+        if (wrapper)
+            av_frame_free(& wrapper);
+
+        if (codec)
+            avcodec_free_context(& codec);
+
+        if (format) {
+            if (format->pb && !(format->oformat->flags & AVFMT_NOFILE))
+                avio_closep(& format->pb);
+
+            avformat_free_context(format);
+        }
+
+        output.clear([this] (packet_item & item) { packet_store.recycle(item.pkt); });
+    }
+
+    void abort ()
+    {
+        input.abort();
+        converted.abort();
+        output.abort();
+    }
+
+    void join ()
+    {
+        if (convert_thread.joinable())
+            convert_thread.join();
+
+        if (encode_thread.joinable())
+            encode_thread.join();
+
+        if (mux_thread.joinable())
+            mux_thread.join();
+    }
+
+    // Stores the first error and stops all stages.
+    void fail (error_code const & ec)
+    {
+        {
+            std::lock_guard<std::mutex> locker{error_mtx};
+
+            if (!error)
+                error = ec;
+        }
+
+        failed = true;
+        abort();
+    }
+
+    bool open_codec (bool global_header, error_code & ec)
+    {
+        if (opts.width <= 0 || opts.height <= 0 || opts.width % 2 || opts.height % 2
+                || opts.frame_rate <= 0) {
+            ec = std::make_error_code(std::errc::invalid_argument);
+            return false;
+        }
+
+        auto codec_impl = avcodec_find_encoder_by_name("libx264");
+
+        if (!codec_impl)
+            codec_impl = avcodec_find_encoder(AV_CODEC_ID_H264);
+
+        if (!codec_impl) {
+            ec = make_av_error(AVERROR_ENCODER_NOT_FOUND);
+            return false;
+        }
+
+        codec = avcodec_alloc_context3(codec_impl);
+        wrapper = av_frame_alloc();
+
+        if (!codec || !wrapper) {
+            ec = make_av_error(AVERROR(ENOMEM));
+            return false;
+        }
+
+        codec->width = opts.width;
+        codec->height = opts.height;
+        codec->time_base = AVRational{1, opts.frame_rate};
+        codec->framerate = AVRational{opts.frame_rate, 1};
+        codec->pix_fmt = AV_PIX_FMT_YUV420P;
+        codec->gop_size = opts.gop_size;
+        codec->max_b_frames = opts.max_b_frames;
+        codec->thread_count = opts.threads;
+        codec->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+        codec->color_range = AVCOL_RANGE_MPEG;
+        codec->colorspace = opts.cs == color_space::bt709
+            ? AVCOL_SPC_BT709 : AVCOL_SPC_SMPTE170M;
+
+        if (opts.bitrate > 0)
+            codec->bit_rate = opts.bitrate;
+
+        if (global_header)
+            codec->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+
+        // Private options of libx264, ignored by other encoders
+        AVDictionary * options = nullptr;
+        av_dict_set(& options, "preset", opts.preset.c_str(), 0);
+
+        if (!opts.tune.empty())
+            av_dict_set(& options, "tune", opts.tune.c_str(), 0);
+
+        if (opts.bitrate <= 0)
+            av_dict_set(& options, "crf", std::to_string(opts.crf).c_str(), 0);
+
+        int rc = avcodec_open2(codec, codec_impl, & options);
+        av_dict_free(& options);
+
+        if (rc < 0) {
+            ec = make_av_error(rc);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool open_output (std::string const & path, error_code & ec)
+    {
+        int rc = avformat_alloc_output_context2(& format, nullptr, nullptr, path.c_str());
+
+        if (rc < 0 || !format) {
+            ec = make_av_error(rc < 0 ? rc : AVERROR_MUXER_NOT_FOUND);
+            return false;
+        }
+
+        if (!open_codec((format->oformat->flags & AVFMT_GLOBALHEADER) != 0, ec))
+            return false;
+
+        stream = avformat_new_stream(format, nullptr);
+
+        if (!stream) {
+            ec = make_av_error(AVERROR(ENOMEM));
+            return false;
+        }
+
+        rc = avcodec_parameters_from_context(stream->codecpar, codec);
+
+        if (rc < 0) {
+            ec = make_av_error(rc);
+            return false;
+        }
+
+        stream->time_base = codec->time_base;
+
+        if (!(format->oformat->flags & AVFMT_NOFILE)) {
+            rc = avio_open(& format->pb, path.c_str(), AVIO_FLAG_WRITE);
+
+            if (rc < 0) {
+                ec = make_av_error(rc);
+                return false;
+            }
+        }
+
+        rc = avformat_write_header(format, nullptr);
+
+        if (rc < 0) {
+            ec = make_av_error(rc);
+            return false;
+        }
+
+        return true;
+    }
+
+    void start ()
+    {
+        convert_thread = std::thread{[this] { convert_loop(); }};
+        encode_thread = std::thread{[this] { encode_loop(); }};
+        mux_thread = std::thread{[this] { mux_loop(); }};
+    }
+
+    void convert_loop ()
+    {
+        frame_item item;
+
+        while (input.pop(item)) {
+            if (!item.eos && item.f.format() != pixel_format::i420) {
+                auto dst = converted_frames.acquire();
+
+                // Stages run in parallel already. Frame size is checked
+                // by `submit()`, so only unsupported format fails.
+                if (!convert(item.f, dst, opts.cs, 1)) {
+                    fail(std::make_error_code(std::errc::not_supported));
+                    break;
+                }
+
+                item.f = std::move(dst);
+            }
+
+            bool eos = item.eos;
+
+            if (!converted.push(std::move(item)) || eos)
+                break;
+        }
+    }
+
+    // Attaches I420 frame to `wrapper` without copying: encoder references
+    // the frame buffer through the `AVBufferRef`.
+    int wrap (frame const & f, std::int64_t pts)
+    {
+        std::unique_ptr<frame> holder {new frame(f)};
+        auto last = f.planes_count() - 1;
+        auto size = f.data(last) + f.stride(last) * f.plane_height(last) - f.data(0);
+
+        wrapper->buf[0] = av_buffer_create(const_cast<std::uint8_t *>(f.data(0))
+            , static_cast<int>(size), release_frame, holder.get(), 0);
+
+        if (!wrapper->buf[0])
+            return AVERROR(ENOMEM);
+
+        holder.release();
+
+        wrapper->format = AV_PIX_FMT_YUV420P;
+        wrapper->width = f.width();
+        wrapper->height = f.height();
+        wrapper->pts = pts;
+
+        for (int i = 0; i < 3; i++) {
+            wrapper->data[i] = const_cast<std::uint8_t *>(f.data(i));
+            wrapper->linesize[i] = static_cast<int>(f.stride(i));
+        }
+
+        return 0;
+    }
+
+    // Receives all available packets from the encoder. Returns false if
+    // the pipeline is stopped.
+    bool receive_packets ()
+    {
+        while (true) {
+            auto pkt = packet_store.acquire();
+
+            if (!pkt) {
+                fail(make_av_error(AVERROR(ENOMEM)));
+                return false;
+            }
+
+            int rc = avcodec_receive_packet(codec, pkt);
+
+            if (rc == AVERROR(EAGAIN) || rc == AVERROR_EOF) {
+                packet_store.recycle(pkt);
+                return true;
+            }
+
+            if (rc < 0) {
+                packet_store.recycle(pkt);
+                fail(make_av_error(rc));
+                return false;
+            }
+
+            packet_item item;
+            item.pkt = pkt;
+
+            if (!output.push(item)) {
+                packet_store.recycle(pkt);
+                return false;
+            }
+        }
+    }
+
+    void encode_loop ()
+    {
+        frame_item item;
+
+        while (converted.pop(item)) {
+            int rc = 0;
+
+            if (item.eos) {
+                // Enter draining mode
+                rc = avcodec_send_frame(codec, nullptr);
+            } else {
+                rc = wrap(item.f, item.pts);
+
+                if (rc >= 0)
+                    rc = avcodec_send_frame(codec, wrapper);
+
+                av_frame_unref(wrapper);
+                item.f = frame{};
+            }
+
+            if (rc < 0) {
+                fail(make_av_error(rc));
+                break;
+            }
+
+            if (!receive_packets())
+                break;
+
+            if (item.eos) {
+                packet_item eos_item;
+                eos_item.eos = true;
+                output.push(eos_item);
+                break;
+            }
+        }
+    }
+
+    void mux_loop ()
+    {
+        packet_item item;
+
+        while (output.pop(item)) {
+            if (item.eos) {
+                if (format) {
+                    int rc = av_write_trailer(format);
+
+                    if (rc < 0)
+                        fail(make_av_error(rc));
+                }
+
+                break;
+            }
+
+            auto pkt = item.pkt;
+
+            if (callback) {
+                packet p;
+                p.data = pkt->data;
+                p.size = static_cast<std::size_t>(pkt->size);
+                p.pts = pkt->pts;
+                p.dts = pkt->dts;
+                p.keyframe = (pkt->flags & AV_PKT_FLAG_KEY) != 0;
+                callback(p);
+            } else {
+                av_packet_rescale_ts(pkt, codec->time_base, stream->time_base);
+                pkt->stream_index = stream->index;
+
+                // Muxer takes ownership of the packet data
+                int rc = av_interleaved_write_frame(format, pkt);
+
+                if (rc < 0) {
+                    packet_store.recycle(pkt);
+                    fail(make_av_error(rc));
+                    break;
+                }
+            }
+
+            packet_store.recycle(pkt);
+            ++packets;
+        }
+    }
+};
+
+encoder::encoder () = default;
+
+encoder::~encoder () = default;
+
+bool encoder::open (std::string const & path
+    , encoder_options const & opts
+    , error_code & ec)
+{
+    _d.reset();
+
+    std::unique_ptr<impl> d {new impl(opts)};
+
+    if (!d->open_output(path, ec))
+        return false;
+
+    d->start();
+    _d = std::move(d);
+    return true;
+}
+
+bool encoder::open (packet_callback callback
+    , encoder_options const & opts
+    , error_code & ec)
+{
+    _d.reset();
+
+    std::unique_ptr<impl> d {new impl(opts)};
+    d->callback = std::move(callback);
+
+    // Parameter sets are repeated in the stream (no global header)
+    if (!d->open_codec(false, ec))
+        return false;
+
+    d->start();
+    _d = std::move(d);
+    return true;
+}
+
+bool encoder::submit (frame const & f, std::int64_t pts)
+{
+    if (!_d || _d->finished || _d->failed || f.empty())
+        return false;
+
+    if (f.width() != _d->opts.width || f.height() != _d->opts.height)
+        return false;
+
+    if (pts < 0)
+        pts = _d->next_pts;
+
+    _d->next_pts = pts + 1;
+
+    frame_item item;
+    item.f = f;
+    item.pts = pts;
+
+    return _d->input.push(std::move(item));
+}
+
+bool encoder::finish (error_code & ec)
+{
+    if (!_d || _d->finished)
+        return false;
+
+    _d->finished = true;
+
+    frame_item eos_item;
+    eos_item.eos = true;
+    _d->input.push(std::move(eos_item));
+    _d->join();
+
+    bool success = !_d->failed;
+
+    if (!success) {
+        std::lock_guard<std::mutex> locker{_d->error_mtx};
+        ec = _d->error;
+    }
+
+    return success;
+}
+
+std::size_t encoder::packets_count () const
+{
+    return _d ? _d->packets.load() : 0;
+}
+
+}} // namespace multimedia::video
@@ -0,0 +1,361 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Intrusive reference counting of frame buffers.
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/multimedia/video.hpp"
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+
+namespace multimedia {
+namespace video {
+
+struct frame_buffer
+{
+    std::unique_ptr<std::uint8_t[]> raw;
+    std::uint8_t * data {nullptr};
+    std::size_t size {0};
+
+    // Number of frame handles referencing the buffer
+    std::atomic<std::size_t> refs {1};
+
+    // Owner pool while the buffer is in use (null for standalone buffers
+    // and for idle ones, so the pool does not reference itself)
+    std::shared_ptr<frame_pool::impl> pool;
+
+    frame_buffer (std::size_t sz, std::size_t alignment)
+        : raw(new std::uint8_t[sz + alignment])
+        , size(sz)
+    {
+        auto addr = reinterpret_cast<std::uintptr_t>(raw.get());
+        addr = (addr + alignment - 1) / alignment * alignment;
+        data = reinterpret_cast<std::uint8_t *>(addr);
+    }
+
+    static void add_ref (frame_buffer * b) noexcept
+    {
+        if (b)
+            b->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void release (frame_buffer * b) noexcept;
+};
+
+static inline std::size_t align_up (std::size_t n, std::size_t alignment)
+{
+    return (n + alignment - 1) / alignment * alignment;
+}
+
+static void plane_geometry (pixel_format format
+    , int width
+    , int height
+    , int plane
+    , std::size_t & row_bytes
+    , int & rows)
+{
+    auto w = static_cast<std::size_t>(width);
+    auto cw = static_cast<std::size_t>((width + 1) / 2);
+    int ch = (height + 1) / 2;
+
+    row_bytes = 0;
+    rows = 0;
+
+    switch (format) {
+        case pixel_format::i420:
+            row_bytes = plane == 0 ? w : cw;
+            rows = plane == 0 ? height : ch;
+            break;
+
+        case pixel_format::nv12:
+            row_bytes = plane == 0 ? w : 2 * cw;
+            rows = plane == 0 ? height : ch;
+            break;
+
+        case pixel_format::yuyv:
+            row_bytes = 4 * cw;
+            rows = height;
+            break;
+
+        case pixel_format::rgb24:
+            row_bytes = 3 * w;
+            rows = height;
+            break;
+
+        case pixel_format::rgba:
+            row_bytes = 4 * w;
+            rows = height;
+            break;
+    }
+}
+
+int frame::planes_count (pixel_format format)
+{
+    switch (format) {
+        case pixel_format::i420:
+            return 3;
+        case pixel_format::nv12:
+            return 2;
+        default:
+            break;
+    }
+
+    return 1;
+}
+
+std::size_t frame::buffer_size (pixel_format format
+    , int width
+    , int height
+    , std::size_t alignment)
+{
+    std::size_t result = 0;
+    auto n = planes_count(format);
+
+    for (int i = 0; i < n; i++) {
+        std::size_t row_bytes = 0;
+        int rows = 0;
+        plane_geometry(format, width, height, i, row_bytes, rows);
+        result += align_up(row_bytes, alignment) * static_cast<std::size_t>(rows);
+    }
+
+    return result;
+}
+
+frame::frame (frame const & other)
+    : _format(other._format)
+    , _width(other._width)
+    , _height(other._height)
+    , _planes_count(other._planes_count)
+    , _buffer(other._buffer)
+{
+    for (int i = 0; i < 3; i++) {
+        _data[i] = other._data[i];
+        _stride[i] = other._stride[i];
+    }
+
+    frame_buffer::add_ref(_buffer);
+}
+
+frame::frame (frame && other) noexcept
+{
+    *this = std::move(other);
+}
+
+frame & frame::operator = (frame const & other)
+{
+    if (this != & other) {
+        frame tmp {other};
+        *this = std::move(tmp);
+    }
+
+    return *this;
+}
+
+frame & frame::operator = (frame && other) noexcept
+{
+    if (this != & other) {
+        frame_buffer::release(_buffer);
+
+        _format = other._format;
+        _width = other._width;
+        _height = other._height;
+        _planes_count = other._planes_count;
+        _buffer = other._buffer;
+
+        for (int i = 0; i < 3; i++) {
+            _data[i] = other._data[i];
+            _stride[i] = other._stride[i];
+            other._data[i] = nullptr;
+            other._stride[i] = 0;
+        }
+
+        other._width = 0;
+        other._height = 0;
+        other._planes_count = 0;
+        other._buffer = nullptr;
+    }
+
+    return *this;
+}
+
+frame::~frame ()
+{
+    frame_buffer::release(_buffer);
+}
+
+void frame::assign (frame_buffer * buffer
+    , pixel_format format
+    , int width
+    , int height
+    , std::size_t alignment)
+{
+    frame_buffer::release(_buffer);
+    _buffer = buffer;
+    _format = format;
+    _width = width;
+    _height = height;
+    _planes_count = planes_count(format);
+
+    std::uint8_t * p = _buffer->data;
+
+    for (int i = 0; i < 3; i++) {
+        if (i < _planes_count) {
+            std::size_t row_bytes = 0;
+            int rows = 0;
+            plane_geometry(format, width, height, i, row_bytes, rows);
+            _data[i] = p;
+            _stride[i] = align_up(row_bytes, alignment);
+            p += _stride[i] * static_cast<std::size_t>(rows);
+        } else {
+            _data[i] = nullptr;
+            _stride[i] = 0;
+        }
+    }
+}
+
+frame frame::allocate (pixel_format format
+    , int width
+    , int height
+    , std::size_t alignment)
+{
+    frame result;
+
+    if (width > 0 && height > 0) {
+        auto size = buffer_size(format, width, height, alignment);
+        result.assign(new frame_buffer(size, alignment), format, width, height, alignment);
+    }
+
+    return result;
+}
+
+std::size_t frame::plane_row_bytes (int plane) const
+{
+    std::size_t row_bytes = 0;
+    int rows = 0;
+
+    if (plane < _planes_count)
+        plane_geometry(_format, _width, _height, plane, row_bytes, rows);
+
+    return row_bytes;
+}
+
+int frame::plane_height (int plane) const
+{
+    std::size_t row_bytes = 0;
+    int rows = 0;
+
+    if (plane < _planes_count)
+        plane_geometry(_format, _width, _height, plane, row_bytes, rows);
+
+    return rows;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// frame_pool
+////////////////////////////////////////////////////////////////////////////////
+struct frame_pool::impl
+{
+    pixel_format format;
+    int width;
+    int height;
+    std::size_t max_free;
+    std::size_t alignment;
+    std::size_t buffer_size;
+
+    mutable std::mutex mtx;
+    std::vector<std::unique_ptr<frame_buffer>> free_buffers;
+
+    // Returns buffer to the pool (or releases it if the pool is full).
+    void recycle (frame_buffer * buffer)
+    {
+        std::unique_ptr<frame_buffer> b {buffer};
+        std::lock_guard<std::mutex> locker{mtx};
+
+        if (free_buffers.size() < max_free)
+            free_buffers.push_back(std::move(b));
+    }
+};
+
+void frame_buffer::release (frame_buffer * b) noexcept
+{
+    if (!b || b->refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+
+    // Frames may outlive the pool: the last frame keeps the pool alive
+    // until the buffer is recycled
+    auto d = std::move(b->pool);
+
+    if (d)
+        d->recycle(b);
+    else
+        delete b;
+}
+
+frame_pool::frame_pool (pixel_format format
+    , int width
+    , int height
+    , std::size_t max_free
+    , std::size_t alignment)
+    : _d(std::make_shared<impl>())
+{
+    _d->format = format;
+    _d->width = width;
+    _d->height = height;
+    _d->max_free = max_free;
+    _d->alignment = alignment;
+    _d->buffer_size = frame::buffer_size(format, width, height, alignment);
+}
+
+frame_pool::~frame_pool () = default;
+
+frame frame_pool::acquire ()
+{
+    std::unique_ptr<frame_buffer> buffer;
+
+    {
+        std::lock_guard<std::mutex> locker{_d->mtx};
+
+        if (!_d->free_buffers.empty()) {
+            buffer = std::move(_d->free_buffers.back());
+            _d->free_buffers.pop_back();
+        }
+    }
+
+    if (!buffer)
+        buffer.reset(new frame_buffer(_d->buffer_size, _d->alignment));
+
+    buffer->refs.store(1, std::memory_order_relaxed);
+    buffer->pool = _d;
+
+    frame result;
+    result.assign(buffer.release(), _d->format, _d->width, _d->height, _d->alignment);
+    return result;
+}
+
+std::size_t frame_pool::free_count () const
+{
+    std::lock_guard<std::mutex> locker{_d->mtx};
+    return _d->free_buffers.size();
+}
+
+pixel_format frame_pool::format () const
+{
+    return _d->format;
+}
+
+int frame_pool::width () const
+{
+    return _d->width;
+}
+
+int frame_pool::height () const
+{
+    return _d->height;
+}
+
+}} // namespace multimedia::video
@@ -0,0 +1,722 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Pyramid levels are scaled from the source by default.
+//      2026.10.19 Single pass pyramid mode (default).
+////////////////////////////////////////////////////////////////////////////////
+#include "pfs/multimedia/video_scaler.hpp"
+#include "parallel_for.hpp"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <cmath>
+
+namespace multimedia {
+namespace video {
+
+static constexpr double PI = 3.14159265358979323846;
+
+// Fixed point precision of the filter weights.
+static constexpr int WEIGHT_BITS = 14;
+
+// Extra precision of the intermediate (vertically filtered) samples.
+static constexpr int INTERMEDIATE_BITS = 7;
+
+static double filter_support (scale_filter filter)
+{
+    switch (filter) {
+        case scale_filter::bicubic:
+            return 2.0;
+        case scale_filter::lanczos:
+            return 3.0;
+        case scale_filter::bilinear:
+        default:
+            break;
+    }
+
+    return 1.0;
+}
+
+static double sinc (double x)
+{
+    if (x == 0.0)
+        return 1.0;
+
+    x *= PI;
+    return std::sin(x) / x;
+}
+
+static double filter_value (scale_filter filter, double x)
+{
+    x = std::fabs(x);
+
+    switch (filter) {
+        case scale_filter::bicubic:
+            if (x < 1.0)
+                return (1.5 * x - 2.5) * x * x + 1.0;
+            if (x < 2.0)
+                return ((-0.5 * x + 2.5) * x - 4.0) * x + 2.0;
+            return 0.0;
+
+        case scale_filter::lanczos:
+            return x < 3.0 ? sinc(x) * sinc(x / 3.0) : 0.0;
+
+        case scale_filter::bilinear:
+        default:
+            break;
+    }
+
+    return x < 1.0 ? 1.0 - x : 0.0;
+}
+
+// One-dimensional resampling table: destination sample `i` is the weighted
+// sum of `taps` contiguous source samples starting at `offsets[i]`. Taps
+// outside of the source are folded into the edge samples, so no clamping is
+// needed in the filter loops.
+struct filter_table
+{
+    int taps;
+    std::vector<int> offsets;
+    std::vector<std::int16_t> weights; // `taps` weights per destination sample
+
+    // Maximum number of destination samples using one source sample
+    std::size_t overlap {0};
+
+    filter_table (scale_filter filter, int src_size, int dst_size)
+    {
+        double scale = static_cast<double>(src_size) / dst_size;
+
+        // Filter is stretched when downscaling to suppress aliasing
+        double fscale = std::max(scale, 1.0);
+        double support = filter_support(filter) * fscale;
+
+        taps = std::min(static_cast<int>(std::ceil(2.0 * support)) + 1, src_size);
+        offsets.resize(static_cast<std::size_t>(dst_size));
+        weights.resize(static_cast<std::size_t>(dst_size) * taps);
+
+        std::vector<double> w(static_cast<std::size_t>(taps));
+
+        for (int i = 0; i < dst_size; i++) {
+            double center = (i + 0.5) * scale;
+            int left = static_cast<int>(std::floor(center - support));
+            int start = std::max(0, std::min(left, src_size - taps));
+
+            std::fill(w.begin(), w.end(), 0.0);
+            double sum = 0.0;
+
+            for (int j = static_cast<int>(std::floor(center - support))
+                    ; j <= static_cast<int>(std::ceil(center + support)); j++) {
+                double v = filter_value(filter, (j + 0.5 - center) / fscale);
+
+                if (v == 0.0)
+                    continue;
+
+                int k = std::max(0, std::min(j, src_size - 1)) - start;
+                w[static_cast<std::size_t>(k)] += v;
+                sum += v;
+            }
+
+            // Quantize normalized weights, rounding error goes to the
+            // largest weight, so the sum is exactly 1.0
+            std::int16_t * q = & weights[static_cast<std::size_t>(i) * taps];
+            int qsum = 0;
+            int largest = 0;
+
+            for (int k = 0; k < taps; k++) {
+                double v = sum != 0.0 ? w[static_cast<std::size_t>(k)] / sum : (k == 0 ? 1.0 : 0.0);
+                q[k] = static_cast<std::int16_t>(std::lround(v * (1 << WEIGHT_BITS)));
+                qsum += q[k];
+
+                if (q[k] > q[largest])
+                    largest = k;
+            }
+
+            q[largest] = static_cast<std::int16_t>(q[largest] + (1 << WEIGHT_BITS) - qsum);
+            offsets[static_cast<std::size_t>(i)] = start;
+        }
+
+        // Offsets do not decrease, so destination samples using the source
+        // sample at `offsets[i]` are the contiguous range [j, i]
+        for (std::size_t i = 0, j = 0; i < offsets.size(); i++) {
+            while (offsets[j] + taps <= offsets[i])
+                j++;
+
+            overlap = std::max(overlap, i - j + 1);
+        }
+    }
+
+    static std::shared_ptr<filter_table const> get (scale_filter filter, int src_size, int dst_size)
+    {
+        using key_type = std::tuple<int, int, int>;
+
+        static std::mutex mtx;
+        static std::map<key_type, std::shared_ptr<filter_table const>> cache;
+
+        key_type key {static_cast<int>(filter), src_size, dst_size};
+        std::lock_guard<std::mutex> locker{mtx};
+        auto pos = cache.find(key);
+
+        if (pos != cache.end())
+            return pos->second;
+
+        auto table = std::make_shared<filter_table const>(filter, src_size, dst_size);
+        cache[key] = table;
+        return table;
+    }
+};
+
+static inline std::uint8_t clamp8 (int v)
+{
+    return static_cast<std::uint8_t>(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+struct plane_job
+{
+    std::uint8_t const * src;
+    std::size_t src_stride;
+    int src_width;          // in pixels
+    std::uint8_t * dst;
+    std::size_t dst_stride;
+    int dst_width;          // in pixels
+    int channels;           // interleaved samples per pixel
+    filter_table const * htable;
+    filter_table const * vtable;
+};
+
+static inline void accumulate_row (std::int32_t * __restrict t
+    , std::uint8_t const * __restrict s
+    , std::int32_t w
+    , std::size_t samples)
+{
+    for (std::size_t x = 0; x < samples; x++)
+        t[x] += w * s[x];
+}
+
+// Rounds vertically filtered row `t` to the intermediate precision and
+// filters it horizontally into the destination row.
+template <int Channels>
+static void finish_row (filter_table const & h
+    , std::int32_t * t
+    , std::size_t src_samples
+    , std::uint8_t * out
+    , int dst_width)
+{
+    int const vround = 1 << (WEIGHT_BITS - INTERMEDIATE_BITS - 1);
+    int const hshift = WEIGHT_BITS + INTERMEDIATE_BITS;
+    int const hround = 1 << (hshift - 1);
+
+    for (std::size_t x = 0; x < src_samples; x++)
+        t[x] = (t[x] + vround) >> (WEIGHT_BITS - INTERMEDIATE_BITS);
+
+    for (int x = 0; x < dst_width; x++) {
+        std::int32_t const * in = t + static_cast<std::size_t>(h.offsets[static_cast<std::size_t>(x)]) * Channels;
+        std::int16_t const * hw = & h.weights[static_cast<std::size_t>(x) * h.taps];
+        std::int32_t acc[Channels];
+
+        for (int c = 0; c < Channels; c++)
+            acc[c] = hround;
+
+        for (int k = 0; k < h.taps; k++) {
+            for (int c = 0; c < Channels; c++)
+                acc[c] += hw[k] * in[k * Channels + c];
+        }
+
+        for (int c = 0; c < Channels; c++)
+            out[x * Channels + c] = clamp8(acc[c] >> hshift);
+    }
+}
+
+// Scales destination rows [row_begin, row_end): vertical pass into the
+// intermediate row, then horizontal pass into the destination.
+template <int Channels>
+static void scale_rows (plane_job const & job, std::size_t row_begin, std::size_t row_end)
+{
+    auto src_samples = static_cast<std::size_t>(job.src_width) * Channels;
+    std::vector<std::int32_t> tmp(src_samples);
+    std::int32_t * t = tmp.data();
+
+    auto const & v = *job.vtable;
+
+    for (auto y = row_begin; y < row_end; y++) {
+        int offset = v.offsets[y];
+        std::int16_t const * vw = & v.weights[y * v.taps];
+
+        // Vertical pass: contiguous multiply-accumulate over whole rows
+        std::fill(tmp.begin(), tmp.end(), 0);
+
+        for (int k = 0; k < v.taps; k++) {
+            std::int32_t w = vw[k];
+
+            if (w != 0) {
+                accumulate_row(t, job.src + static_cast<std::size_t>(offset + k) * job.src_stride
+                    , w, src_samples);
+            }
+        }
+
+        finish_row<Channels>(*job.htable, t, src_samples, job.dst + y * job.dst_stride, job.dst_width);
+    }
+}
+
+struct pyramid_level
+{
+    std::uint8_t * dst;
+    std::size_t dst_stride;
+    int dst_width;          // in pixels
+    filter_table const * htable;
+    filter_table const * vtable;
+};
+
+struct pyramid_job
+{
+    std::uint8_t const * src;
+    std::size_t src_stride;
+    int src_width;          // in pixels
+    std::vector<pyramid_level> levels;
+};
+
+// Destination rows of the level [first, last) processed by the band of
+// source rows [band_begin, band_end): rows whose filter window starts in
+// the band. Returns the end of source rows read for them.
+static std::size_t band_level_rows (filter_table const & v
+    , std::size_t band_begin
+    , std::size_t band_end
+    , std::size_t & first
+    , std::size_t & last)
+{
+    auto lower = [& v] (std::size_t row) {
+        return static_cast<std::size_t>(std::lower_bound(v.offsets.begin(), v.offsets.end()
+            , static_cast<int>(row)) - v.offsets.begin());
+    };
+
+    first = lower(band_begin);
+    last = lower(band_end);
+
+    return first < last
+        ? static_cast<std::size_t>(v.offsets[last - 1] + v.taps)
+        : band_begin;
+}
+
+// Single pass over the band of source rows [band_begin, band_end) (and the
+// following rows completing windows started in the band). Each source row
+// is accumulated into the vertical filters of all open destination rows of
+// all levels, rows whose window ends are filtered horizontally and written.
+template <int Channels>
+static void scale_rows_single_pass (pyramid_job const & job, std::size_t band_begin, std::size_t band_end)
+{
+    struct level_state
+    {
+        std::size_t next_open;  // Next destination row to open
+        std::size_t next_close; // Oldest open destination row
+        std::size_t end;
+        std::vector<std::int32_t> acc; // Ring of `overlap` open rows
+    };
+
+    auto src_samples = static_cast<std::size_t>(job.src_width) * Channels;
+    std::vector<level_state> states(job.levels.size());
+    std::size_t rows_end = band_begin;
+
+    for (std::size_t i = 0; i < job.levels.size(); i++) {
+        auto const & v = *job.levels[i].vtable;
+        auto & st = states[i];
+
+        rows_end = std::max(rows_end, band_level_rows(v, band_begin, band_end, st.next_open, st.end));
+        st.next_close = st.next_open;
+
+        if (st.next_open < st.end)
+            st.acc.resize(v.overlap * src_samples);
+    }
+
+    for (auto r = band_begin; r < rows_end; r++) {
+        std::uint8_t const * s = job.src + r * job.src_stride;
+
+        for (std::size_t i = 0; i < job.levels.size(); i++) {
+            auto const & level = job.levels[i];
+            auto const & v = *level.vtable;
+            auto & st = states[i];
+            auto slot = [& st, & v, src_samples] (std::size_t y) {
+                return st.acc.data() + (y % v.overlap) * src_samples;
+            };
+
+            while (st.next_open < st.end && static_cast<std::size_t>(v.offsets[st.next_open]) <= r) {
+                auto t = slot(st.next_open++);
+                std::fill(t, t + src_samples, 0);
+            }
+
+            for (auto y = st.next_close; y < st.next_open; y++) {
+                std::int32_t w = v.weights[y * static_cast<std::size_t>(v.taps) + (r - static_cast<std::size_t>(v.offsets[y]))];
+
+                if (w != 0)
+                    accumulate_row(slot(y), s, w, src_samples);
+            }
+
+            while (st.next_close < st.next_open
+                    && static_cast<std::size_t>(v.offsets[st.next_close] + v.taps) == r + 1) {
+                auto y = st.next_close++;
+                finish_row<Channels>(*level.htable, slot(y), src_samples
+                    , level.dst + y * level.dst_stride, level.dst_width);
+            }
+        }
+    }
+}
+
+static bool supported (pixel_format format)
+{
+    return format != pixel_format::yuyv;
+}
+
+static int plane_channels (pixel_format format, int plane)
+{
+    switch (format) {
+        case pixel_format::nv12:
+            return plane == 0 ? 1 : 2;
+        case pixel_format::rgb24:
+            return 3;
+        case pixel_format::rgba:
+            return 4;
+        default:
+            break;
+    }
+
+    return 1;
+}
+
+using rows_fn = void (*) (plane_job const &, std::size_t, std::size_t);
+using single_pass_fn = void (*) (pyramid_job const &, std::size_t, std::size_t);
+
+// Number of row bands: bands of at least 16 rows, each band reads `taps`
+// source rows per destination row, small bands would re-read too much
+static std::size_t band_count (std::size_t rows, std::size_t threads)
+{
+    auto parts = threads == 0 ? parallel_concurrency() : threads;
+    return std::max(std::size_t{1}, std::min(parts, rows / 16));
+}
+
+// Band [begin, end) of `parallel_for()` chunking.
+static void band_range (std::size_t rows, std::size_t parts, std::size_t i
+    , std::size_t & begin, std::size_t & end)
+{
+    begin = rows * i / parts;
+    end = rows * (i + 1) / parts;
+}
+
+static std::shared_ptr<filter_table const> horizontal_table (scale_filter filter
+    , frame const & src
+    , frame const & dst
+    , int plane)
+{
+    int channels = plane_channels(src.format(), plane);
+    return filter_table::get(filter, static_cast<int>(src.plane_row_bytes(plane)) / channels
+        , static_cast<int>(dst.plane_row_bytes(plane)) / channels);
+}
+
+static std::shared_ptr<filter_table const> vertical_table (scale_filter filter
+    , frame const & src
+    , frame const & dst
+    , int plane)
+{
+    return filter_table::get(filter, src.plane_height(plane), dst.plane_height(plane));
+}
+
+static void scale_plane (scale_filter filter
+    , frame const & src
+    , frame & dst
+    , int plane
+    , std::size_t threads)
+{
+    int channels = plane_channels(src.format(), plane);
+
+    plane_job job;
+    job.src = src.data(plane);
+    job.src_stride = src.stride(plane);
+    job.src_width = static_cast<int>(src.plane_row_bytes(plane)) / channels;
+    job.dst = dst.data(plane);
+    job.dst_stride = dst.stride(plane);
+    job.dst_width = static_cast<int>(dst.plane_row_bytes(plane)) / channels;
+    job.channels = channels;
+
+    auto htable = horizontal_table(filter, src, dst, plane);
+    auto vtable = vertical_table(filter, src, dst, plane);
+    job.htable = htable.get();
+    job.vtable = vtable.get();
+
+    rows_fn fn = nullptr;
+
+    switch (channels) {
+        case 1: fn = & scale_rows<1>; break;
+        case 2: fn = & scale_rows<2>; break;
+        case 3: fn = & scale_rows<3>; break;
+        case 4:
+        default:
+            fn = & scale_rows<4>;
+            break;
+    }
+
+    auto rows = static_cast<std::size_t>(dst.plane_height(plane));
+
+    parallel_for(rows, band_count(rows, threads), [fn, & job] (std::size_t begin, std::size_t end) {
+        fn(job, begin, end);
+    });
+}
+
+// Bytes of distinct source rows read by the bands of `scale_plane()`.
+static std::uint64_t scale_plane_traffic (scale_filter filter
+    , frame const & src
+    , frame const & dst
+    , int plane
+    , std::size_t threads)
+{
+    auto vtable = vertical_table(filter, src, dst, plane);
+    auto rows = static_cast<std::size_t>(dst.plane_height(plane));
+    auto parts = band_count(rows, threads);
+    std::uint64_t result = 0;
+
+    for (std::size_t i = 0; i < parts; i++) {
+        std::size_t begin = 0;
+        std::size_t end = 0;
+        band_range(rows, parts, i, begin, end);
+
+        if (begin < end) {
+            auto read_rows = vtable->offsets[end - 1] + vtable->taps - vtable->offsets[begin];
+            result += static_cast<std::uint64_t>(read_rows) * src.plane_row_bytes(plane);
+        }
+    }
+
+    return result;
+}
+
+// Scales the plane of the source into all destinations in a single pass,
+// bands of source rows are processed in parallel.
+static void scale_plane_single_pass (scale_filter filter
+    , frame const & src
+    , frame * dsts
+    , std::size_t count
+    , int plane
+    , std::size_t threads)
+{
+    int channels = plane_channels(src.format(), plane);
+    std::vector<std::shared_ptr<filter_table const>> tables;
+
+    pyramid_job job;
+    job.src = src.data(plane);
+    job.src_stride = src.stride(plane);
+    job.src_width = static_cast<int>(src.plane_row_bytes(plane)) / channels;
+
+    for (std::size_t i = 0; i < count; i++) {
+        tables.push_back(horizontal_table(filter, src, dsts[i], plane));
+        tables.push_back(vertical_table(filter, src, dsts[i], plane));
+
+        pyramid_level level;
+        level.dst = dsts[i].data(plane);
+        level.dst_stride = dsts[i].stride(plane);
+        level.dst_width = static_cast<int>(dsts[i].plane_row_bytes(plane)) / channels;
+        level.htable = tables[tables.size() - 2].get();
+        level.vtable = tables[tables.size() - 1].get();
+        job.levels.push_back(level);
+    }
+
+    single_pass_fn fn = nullptr;
+
+    switch (channels) {
+        case 1: fn = & scale_rows_single_pass<1>; break;
+        case 2: fn = & scale_rows_single_pass<2>; break;
+        case 3: fn = & scale_rows_single_pass<3>; break;
+        case 4:
+        default:
+            fn = & scale_rows_single_pass<4>;
+            break;
+    }
+
+    auto rows = static_cast<std::size_t>(src.plane_height(plane));
+
+    parallel_for(rows, band_count(rows, threads), [fn, & job] (std::size_t begin, std::size_t end) {
+        fn(job, begin, end);
+    });
+}
+
+// Bytes of source rows read by the bands of `scale_plane_single_pass()`.
+static std::uint64_t single_pass_traffic (scale_filter filter
+    , frame const & src
+    , frame const * dsts
+    , std::size_t count
+    , int plane
+    , std::size_t threads)
+{
+    std::vector<std::shared_ptr<filter_table const>> vtables;
+
+    for (std::size_t i = 0; i < count; i++)
+        vtables.push_back(vertical_table(filter, src, dsts[i], plane));
+
+    auto rows = static_cast<std::size_t>(src.plane_height(plane));
+    auto parts = band_count(rows, threads);
+    std::uint64_t result = 0;
+
+    for (std::size_t i = 0; i < parts; i++) {
+        std::size_t begin = 0;
+        std::size_t end = 0;
+        std::size_t rows_end = 0;
+        band_range(rows, parts, i, begin, end);
+
+        if (begin == end)
+            continue;
+
+        rows_end = begin;
+
+        for (auto const & v: vtables) {
+            std::size_t first = 0;
+            std::size_t last = 0;
+            rows_end = std::max(rows_end, band_level_rows(*v, begin, end, first, last));
+        }
+
+        result += static_cast<std::uint64_t>(rows_end - begin) * src.plane_row_bytes(plane);
+    }
+
+    return result;
+}
+
+static bool compatible (frame const & src, frame const & dst)
+{
+    return !src.empty() && !dst.empty() && src.format() == dst.format() && supported(src.format());
+}
+
+bool scaler::scale (frame const & src, frame & dst) const
+{
+    if (!compatible(src, dst))
+        return false;
+
+    for (int i = 0; i < src.planes_count(); i++)
+        scale_plane(_filter, src, dst, i, _threads);
+
+    return true;
+}
+
+// Order of the cascade: descending order of area, each level is scaled from
+// the last produced frame that is still not smaller than it (`nullptr` is
+// the source).
+static std::vector<std::pair<std::size_t, frame const *>> cascade_order (frame const * dsts
+    , std::size_t count)
+{
+    std::vector<std::size_t> order(count);
+
+    for (std::size_t i = 0; i < count; i++)
+        order[i] = i;
+
+    std::sort(order.begin(), order.end(), [dsts] (std::size_t a, std::size_t b) {
+        return static_cast<long long>(dsts[a].width()) * dsts[a].height()
+            > static_cast<long long>(dsts[b].width()) * dsts[b].height();
+    });
+
+    std::vector<std::pair<std::size_t, frame const *>> result;
+
+    for (std::size_t n = 0; n < count; n++) {
+        frame const & dst = dsts[order[n]];
+        frame const * from = nullptr;
+
+        for (std::size_t m = n; m > 0; m--) {
+            frame const & candidate = dsts[order[m - 1]];
+
+            if (candidate.width() >= dst.width() && candidate.height() >= dst.height()) {
+                from = & candidate;
+                break;
+            }
+        }
+
+        result.emplace_back(order[n], from);
+    }
+
+    return result;
+}
+
+bool scaler::scale (frame const & src
+    , frame * dsts
+    , std::size_t count
+    , pyramid_mode mode) const
+{
+    switch (mode) {
+        case pyramid_mode::direct:
+            for (std::size_t i = 0; i < count; i++) {
+                if (!scale(src, dsts[i]))
+                    return false;
+            }
+
+            return true;
+
+        case pyramid_mode::cascade:
+            for (auto const & step: cascade_order(dsts, count)) {
+                if (!scale(step.second != nullptr ? *step.second : src, dsts[step.first]))
+                    return false;
+            }
+
+            return true;
+
+        case pyramid_mode::single_pass:
+        default:
+            break;
+    }
+
+    for (std::size_t i = 0; i < count; i++) {
+        if (!compatible(src, dsts[i]))
+            return false;
+    }
+
+    if (count == 0)
+        return true;
+
+    for (int i = 0; i < src.planes_count(); i++)
+        scale_plane_single_pass(_filter, src, dsts, count, i, _threads);
+
+    return true;
+}
+
+pyramid_traffic scaler::traffic (frame const & src
+    , frame const * dsts
+    , std::size_t count
+    , pyramid_mode mode) const
+{
+    pyramid_traffic result;
+
+    for (std::size_t i = 0; i < count; i++) {
+        if (!compatible(src, dsts[i]))
+            return result;
+    }
+
+    for (int p = 0; p < src.planes_count(); p++) {
+        switch (mode) {
+            case pyramid_mode::direct:
+                for (std::size_t i = 0; i < count; i++)
+                    result.source_bytes += scale_plane_traffic(_filter, src, dsts[i], p, _threads);
+
+                break;
+
+            case pyramid_mode::cascade:
+                for (auto const & step: cascade_order(dsts, count)) {
+                    if (step.second == nullptr) {
+                        result.source_bytes += scale_plane_traffic(_filter, src, dsts[step.first], p, _threads);
+                    } else {
+                        result.level_bytes += scale_plane_traffic(_filter, *step.second
+                            , dsts[step.first], p, _threads);
+                    }
+                }
+
+                break;
+
+            case pyramid_mode::single_pass:
+            default:
+                if (count > 0)
+                    result.source_bytes += single_pass_traffic(_filter, src, dsts, count, p, _threads);
+
+                break;
+        }
+    }
+
+    return result;
+}
+
+}} // namespace multimedia::video
@@ -0,0 +1,269 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Added input ring overrun case.
+////////////////////////////////////////////////////////////////////////////////
+#include "check.hpp"
+#include "pfs/multimedia/aggregate_input.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+
+using namespace multimedia::audio;
+
+static double const PI = 3.14159265358979323846;
+static int const NOMINAL_RATE = 48000;
+
+// Signal of all devices (e.g. microphones picking up the same source).
+static double source (double t)
+{
+    return 0.5 * std::sin(2 * PI * 97 * t) + 0.3 * std::sin(2 * PI * 31 * t);
+}
+
+struct simulated_device
+{
+    double ppm;          // Clock deviation from the nominal rate
+    double start;        // Capture time of the first frame (seconds)
+    std::size_t fragment_frames;
+    int channels;
+    std::uint64_t frames; // Captured frames
+
+    double rate () const
+    {
+        return NOMINAL_RATE * (1 + ppm * 1e-6);
+    }
+
+    double time_at (std::uint64_t frame) const
+    {
+        return start + static_cast<double>(frame) / rate();
+    }
+};
+
+// Simulates capture of one source by the devices with skewed clocks,
+// different fragment sizes and start times. Timestamps have scheduling
+// jitter. Lag of each device relative to the master is measured in one
+// second blocks of the aggregated stream.
+//
+// With nonzero `stall` the master capture thread stalls for `stall` seconds
+// in the middle: its fragments are delivered late in a burst, meanwhile the
+// other devices overrun the (small) input rings. Lost frames must not
+// disturb the alignment after the stall.
+static void skewed_devices (int jitter_usec, int seconds, double stall = 0)
+{
+    std::vector<simulated_device> devs = {
+          simulated_device{0, 0, 480, 2, 0}
+        , simulated_device{200, -0.2, 256, 1, 0}
+        , simulated_device{-150, 0.123, 1024, 2, 0}
+    };
+
+    std::vector<aggregate_device> devices;
+
+    for (auto const & d: devs)
+        devices.push_back(aggregate_device{"", d.channels});
+
+    aggregate_options opts;
+    opts.sample_rate = NOMINAL_RATE;
+
+    // Rings overrun in the stall
+    if (stall > 0)
+        opts.input_ring_frames = 4800;
+
+    double const stall_begin = seconds / 2;
+    double const stall_end = stall_begin + stall;
+
+    aggregate_input aggregate {devices, opts};
+
+    CHECK(aggregate.devices_count() == devs.size());
+    CHECK(aggregate.channels() == 5);
+
+    std::mt19937 rng {1};
+    std::uniform_int_distribution<int> jitter {-jitter_usec, jitter_usec};
+
+    auto stride = static_cast<std::size_t>(aggregate.channels());
+    std::size_t const offsets[] = {0, 2, 3};
+
+    std::vector<float> fragment;
+    std::vector<float> output(4096 * stride);
+
+    // Lag estimation sums (per device) and the previous two frames
+    std::vector<float> prev1(stride, 0.f);
+    std::vector<float> prev2(stride, 0.f);
+    double sum_xd[3] = {0, 0, 0};
+    double sum_dd = 0;
+    std::uint64_t rows = 0;
+    double max_lag[3] = {0, 0, 0};
+
+    // Master fragments held in the stall
+    struct held_fragment
+    {
+        std::vector<float> samples;
+        std::size_t frames;
+        std::int64_t time_usec;
+    };
+
+    std::vector<held_fragment> held;
+
+    auto consume = [&] {
+        std::size_t n = 0;
+
+        while ((n = aggregate.read(output.data(), 4096)) > 0) {
+            for (std::size_t i = 0; i < n; i++, rows++) {
+                auto frame = output.data() + i * stride;
+
+                // Skip settling. Derivative of the master signal at the
+                // previous frame: the difference between the master and the
+                // device is `lag * derivative`.
+                if (rows > static_cast<std::uint64_t>(NOMINAL_RATE) * 30) {
+                    double d = (frame[0] - prev2[0]) / 2;
+                    sum_dd += d * d;
+
+                    for (std::size_t k = 1; k < devs.size(); k++)
+                        sum_xd[k] += (prev1[0] - prev1[offsets[k]]) * d;
+                }
+
+                prev2 = prev1;
+                prev1.assign(frame, frame + stride);
+
+                if (rows % NOMINAL_RATE == 0 && sum_dd > 0) {
+                    // Frames around the stall are not aligned
+                    auto block_time = static_cast<double>(rows) / NOMINAL_RATE;
+                    bool skip = stall > 0 && block_time > stall_begin && block_time < stall_end + 5;
+
+                    for (std::size_t k = 1; k < devs.size(); k++) {
+                        if (!skip)
+                            max_lag[k] = std::max(max_lag[k], std::fabs(sum_xd[k] / sum_dd));
+
+                        sum_xd[k] = 0;
+                    }
+
+                    sum_dd = 0;
+                }
+            }
+        }
+    };
+
+    while (true) {
+        // Next completed fragment
+        std::size_t k = 0;
+
+        for (std::size_t i = 1; i < devs.size(); i++) {
+            if (devs[i].time_at(devs[i].frames + devs[i].fragment_frames)
+                    < devs[k].time_at(devs[k].frames + devs[k].fragment_frames)) {
+                k = i;
+            }
+        }
+
+        auto & d = devs[k];
+        auto time = d.time_at(d.frames);
+
+        if (time > seconds)
+            break;
+
+        fragment.resize(d.fragment_frames * static_cast<std::size_t>(d.channels));
+
+        for (std::size_t i = 0; i < d.fragment_frames; i++) {
+            auto value = static_cast<float>(source(d.time_at(d.frames + i)));
+            std::fill_n(fragment.data() + i * static_cast<std::size_t>(d.channels), d.channels, value);
+        }
+
+        // Timestamps are positive
+        auto time_usec = static_cast<std::int64_t>(std::llround((time + 1) * 1e6)) + jitter(rng);
+
+        d.frames += d.fragment_frames;
+
+        if (k == 0 && time >= stall_begin && time < stall_end) {
+            held.push_back(held_fragment{fragment, d.fragment_frames, time_usec});
+            continue;
+        }
+
+        if (k == 0) {
+            for (auto const & h: held) {
+                CHECK(aggregate.write(0, h.samples.data(), h.frames, h.time_usec));
+                consume();
+            }
+
+            held.clear();
+        }
+
+        CHECK(aggregate.write(k, fragment.data(), d.fragment_frames, time_usec));
+        consume();
+    }
+
+    std::cout << "jitter " << jitter_usec << " us";
+
+    if (stall > 0)
+        std::cout << ", stall " << stall << " s";
+
+    std::cout << ":";
+
+    for (std::size_t k = 0; k < devs.size(); k++) {
+        auto st = aggregate.stats(k);
+
+        std::cout << " dev" << k << " drift " << st.drift_ppm << " ppm";
+
+        if (k > 0)
+            std::cout << ", max lag " << max_lag[k] << ", realign " << st.realignments
+                << ", overrun " << st.overrun_frames;
+
+        std::cout << ";";
+
+        CHECK(std::fabs(st.drift_ppm - devs[k].ppm) < 100);
+
+        if (k == 0 || stall == 0)
+            CHECK(st.overrun_frames == 0);
+
+        if (k > 0) {
+            // Alignment accuracy is limited by the timestamp jitter, see
+            // `aggregate_input`
+            CHECK(max_lag[k] < 1 + jitter_usec * 0.012);
+            CHECK(st.underrun_frames == 0);
+            CHECK(st.realignments == 1);
+
+            // Frames lost in the stall are replaced by silence, not detected
+            // as misalignment
+            if (stall > 0)
+                CHECK(st.overrun_frames > 0);
+        }
+    }
+
+    std::cout << "\n";
+
+    CHECK(rows > static_cast<std::uint64_t>(NOMINAL_RATE) * (seconds - 1));
+}
+
+static void invalid_writes ()
+{
+    aggregate_options opts;
+    opts.max_frames = 480;
+
+    aggregate_input aggregate {{aggregate_device{"a", 2}, aggregate_device{"b", 0}}, opts};
+
+    // Device without channels is treated as mono
+    CHECK(aggregate.channels() == 3);
+    CHECK(aggregate.device(1).channels == 1);
+
+    std::vector<float> samples(opts.max_frames * 2 * 2);
+
+    CHECK(!aggregate.write(2, samples.data(), 10, 0));
+    CHECK(!aggregate.write(0, samples.data(), opts.max_frames + 1, 0));
+    CHECK(aggregate.write(1, samples.data(), opts.max_frames, 0));
+    CHECK(aggregate.available() == 0);
+    CHECK(aggregate.read(samples.data(), 10) == 0);
+}
+
+int main ()
+{
+    skewed_devices(0, 120);
+    skewed_devices(300, 120);
+    skewed_devices(1000, 120);
+    skewed_devices(300, 120, 0.5);
+    invalid_writes();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,205 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "check.hpp"
+#include "pfs/multimedia/audio_coro.hpp"
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace multimedia::audio;
+
+// Fire-and-forget coroutine.
+struct task
+{
+    struct promise_type
+    {
+        task get_return_object () noexcept { return {}; }
+        std::suspend_never initial_suspend () noexcept { return {}; }
+        std::suspend_never final_suspend () noexcept { return {}; }
+        void return_void () noexcept {}
+        void unhandled_exception () { std::terminate(); }
+    };
+};
+
+// Executor resuming coroutines on the thread calling `run_until()`.
+class queue_executor
+{
+    std::mutex _mtx;
+    std::condition_variable _cond;
+    std::deque<std::coroutine_handle<>> _queue;
+
+public:
+    executor get ()
+    {
+        return [this] (std::coroutine_handle<> h) {
+            std::lock_guard<std::mutex> locker{_mtx};
+            _queue.push_back(h);
+            _cond.notify_one();
+        };
+    }
+
+    // Resumes posted coroutines until `done` is set or timeout expires.
+    // Returns false on timeout.
+    bool run_until (std::atomic<bool> const & done, std::chrono::seconds timeout)
+    {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        std::unique_lock<std::mutex> locker{_mtx};
+
+        while (!done) {
+            if (_queue.empty()) {
+                if (_cond.wait_until(locker, deadline) == std::cv_status::timeout && _queue.empty())
+                    return done;
+
+                continue;
+            }
+
+            auto h = _queue.front();
+            _queue.pop_front();
+
+            locker.unlock();
+            h.resume();
+            locker.lock();
+        }
+
+        return true;
+    }
+};
+
+struct query_result
+{
+    device_info default_input;
+    device_info default_output;
+    std::vector<device_info> inputs;
+    std::vector<device_info> outputs;
+    bool resumed_on_executor {true};
+};
+
+static task query (executor ex, query_result & r, std::atomic<bool> & done)
+{
+    auto caller = std::this_thread::get_id();
+    bool check_thread = static_cast<bool>(ex);
+
+    r.default_input = co_await default_input_device_co(ex);
+    r.resumed_on_executor = r.resumed_on_executor && (!check_thread || std::this_thread::get_id() == caller);
+
+    r.default_output = co_await default_output_device_co(ex);
+    r.resumed_on_executor = r.resumed_on_executor && (!check_thread || std::this_thread::get_id() == caller);
+
+    r.inputs = co_await fetch_devices_co(device_mode::input, ex);
+    r.resumed_on_executor = r.resumed_on_executor && (!check_thread || std::this_thread::get_id() == caller);
+
+    r.outputs = co_await fetch_devices_co(device_mode::output, ex);
+    r.resumed_on_executor = r.resumed_on_executor && (!check_thread || std::this_thread::get_id() == caller);
+
+    done = true;
+}
+
+static bool contains (std::vector<device_info> const & devices, std::string const & name)
+{
+    return std::any_of(devices.begin(), devices.end(), [& name] (device_info const & d) {
+        return d.name == name;
+    });
+}
+
+// Results are consistent: default devices are in the lists. Without audio
+// server requests complete with empty results.
+static void check_consistent (query_result const & r)
+{
+    if (!r.default_input.name.empty())
+        CHECK(contains(r.inputs, r.default_input.name));
+
+    if (!r.default_output.name.empty())
+        CHECK(contains(r.outputs, r.default_output.name));
+}
+
+// Coroutine is resumed directly by the thread completing the request.
+static query_result without_executor ()
+{
+    query_result r;
+    std::atomic<bool> done {false};
+
+    query(executor{}, r, done);
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+    while (!done && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    CHECK(done);
+    check_consistent(r);
+    return r;
+}
+
+// Coroutine is resumed by the executor on this thread after each request.
+static query_result with_executor ()
+{
+    query_result r;
+    std::atomic<bool> done {false};
+    queue_executor ex;
+
+    query(ex.get(), r, done);
+
+    CHECK(ex.run_until(done, std::chrono::seconds(10)));
+    CHECK(r.resumed_on_executor);
+    check_consistent(r);
+    return r;
+}
+
+int main ()
+{
+    auto a = without_executor();
+    auto b = with_executor();
+
+    std::cout << "inputs: " << a.inputs.size() << ", outputs: " << a.outputs.size()
+        << ", default input: '" << a.default_input.name
+        << "', default output: '" << a.default_output.name << "'\n";
+
+    // The same devices are reported in both modes
+    CHECK(a.inputs.size() == b.inputs.size());
+    CHECK(a.outputs.size() == b.outputs.size());
+    CHECK(a.default_input.name == b.default_input.name);
+    CHECK(a.default_output.name == b.default_output.name);
+
+    // Many coroutines awaiting concurrently
+    int const count = 32;
+    std::vector<query_result> results(count);
+    std::vector<std::atomic<bool>> finished(count);
+    queue_executor ex;
+
+    for (int i = 0; i < count; i++)
+        query(ex.get(), results[i], finished[i]);
+
+    for (int i = 0; i < count; i++) {
+        CHECK(ex.run_until(finished[i], std::chrono::seconds(10)));
+        CHECK(results[i].inputs.size() == a.inputs.size());
+    }
+
+    return TEST_RESULT();
+}
+
+#else
+
+int main ()
+{
+    std::cout << "coroutines are not supported by the compiler\n";
+    return EXIT_SUCCESS;
+}
+
+#endif
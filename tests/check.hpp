@@ -0,0 +1,38 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <iostream>
+#include <cstdlib>
+
+// Minimal checks for self-contained test programs: failed checks are
+// reported and counted, `TEST_RESULT()` is returned from `main()`.
+namespace multimedia {
+namespace test {
+
+inline int & failures ()
+{
+    static int counter = 0;
+    return counter;
+}
+
+inline bool check (bool success, char const * expr, char const * file, int line)
+{
+    if (!success) {
+        failures()++;
+        std::cerr << file << ":" << line << ": check failed: " << expr << "\n";
+    }
+
+    return success;
+}
+
+}} // namespace multimedia::test
+
+#define CHECK(expr) multimedia::test::check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
+
+#define TEST_RESULT() (multimedia::test::failures() == 0 ? EXIT_SUCCESS : EXIT_FAILURE)
@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "check.hpp"
+#include "pfs/multimedia/drift_compensator.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+
+using namespace multimedia::audio;
+
+static int const NOMINAL_RATE = 48000;
+static std::size_t const FRAGMENT_FRAMES = 480;
+
+// Simulates the capture device (e.g. monitor of the first null sink) and
+// the playback device (second null sink) running at artificially skewed
+// rates. Captured frames are resampled by the compensator into the queue
+// drained by the playback device. Timestamps have scheduling jitter.
+static void skewed_clocks (double capture_ppm, double playback_ppm, int seconds)
+{
+    drift_options opts;
+    opts.channels = 1;
+    opts.sample_rate = NOMINAL_RATE;
+
+    drift_compensator dc {opts};
+
+    double capture_rate = NOMINAL_RATE * (1 + capture_ppm * 1e-6);
+    double playback_rate = NOMINAL_RATE * (1 + playback_ppm * 1e-6);
+
+    std::mt19937 rng {1};
+    std::uniform_int_distribution<int> jitter {-200, 200};
+
+    std::vector<float> input(FRAGMENT_FRAMES);
+    std::vector<float> output(dc.output_frames_max(FRAGMENT_FRAMES));
+
+    std::uint64_t captured = 0;
+    std::uint64_t played = 0;
+    std::size_t queued = opts.target_latency_frames;
+    std::size_t underruns = 0;
+    double max_error = 0;
+    double error_sum = 0;
+    double ratio_sum = 0;
+    std::size_t error_count = 0;
+
+    while (true) {
+        double capture_time = static_cast<double>(captured + FRAGMENT_FRAMES) / capture_rate;
+        double playback_time = static_cast<double>(played + FRAGMENT_FRAMES) / playback_rate;
+        double now = std::min(capture_time, playback_time);
+
+        if (now > seconds)
+            break;
+
+        auto now_usec = static_cast<std::int64_t>(now * 1e6);
+
+        if (capture_time <= playback_time) {
+            for (std::size_t i = 0; i < FRAGMENT_FRAMES; i++)
+                input[i] = static_cast<float>(std::sin(0.01 * static_cast<double>(captured + i)));
+
+            captured += FRAGMENT_FRAMES;
+            dc.update_input_clock(clock_sample{now_usec + jitter(rng), captured});
+            queued += dc.process(input.data(), FRAGMENT_FRAMES, output.data());
+        } else {
+            played += FRAGMENT_FRAMES;
+            dc.update_output_clock(clock_sample{now_usec + jitter(rng), played});
+
+            if (queued < FRAGMENT_FRAMES) {
+                underruns++;
+                queued = 0;
+            } else {
+                queued -= FRAGMENT_FRAMES;
+            }
+
+            dc.update_latency(queued);
+
+            // Skip settling
+            if (now > 60) {
+                double error = static_cast<double>(queued)
+                    - static_cast<double>(opts.target_latency_frames);
+                max_error = std::max(max_error, std::fabs(error));
+                error_sum += error;
+                ratio_sum += dc.ratio();
+                error_count++;
+            }
+        }
+    }
+
+    double expected_ratio = playback_rate / capture_rate;
+    double mean_error = error_sum / static_cast<double>(error_count);
+    double mean_ratio = ratio_sum / static_cast<double>(error_count);
+
+    std::cout << "capture " << capture_ppm << " ppm, playback " << playback_ppm << " ppm"
+        << ": estimated " << dc.input_clock().drift_ppm() << " / " << dc.output_clock().drift_ppm() << " ppm"
+        << ", mean ratio error " << (mean_ratio / expected_ratio - 1) * 1e6 << " ppm"
+        << ", mean latency error " << mean_error << " frames"
+        << ", max " << max_error << " frames\n";
+
+    CHECK(underruns == 0);
+
+    // Latency oscillates by one fragment due to the fragment phase, but
+    // does not drift away
+    CHECK(max_error < 2 * FRAGMENT_FRAMES);
+    CHECK(std::fabs(mean_error) < FRAGMENT_FRAMES / 2);
+
+    // Rates are estimated from the jittered timestamps of the short window
+    CHECK(std::fabs(dc.input_clock().rate() / capture_rate - 1) < 50e-6);
+    CHECK(std::fabs(dc.output_clock().rate() / playback_rate - 1) < 50e-6);
+    CHECK(std::fabs(mean_ratio / expected_ratio - 1) < 5e-6);
+}
+
+int main ()
+{
+    skewed_clocks(300, -100, 1800);
+    skewed_clocks(-250, 150, 1800);
+    skewed_clocks(0, 0, 300);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "check.hpp"
+#include "pfs/multimedia/encoder_pipeline.hpp"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+using namespace multimedia::audio;
+
+static std::size_t const FRAMES = 480;
+
+// Checks that fragments arrive in order and are never encoded concurrently,
+// emits one packet per fragment holding the first sample.
+class checking_encoder: public encoder
+{
+    std::atomic<bool> _busy {false};
+    std::uint64_t _next_pts {0};
+
+public:
+    std::atomic<bool> failed {false};
+    std::atomic<int> flushes {0};
+
+public:
+    void encode (float const * samples
+        , std::size_t frames
+        , std::uint64_t pts
+        , packet_emitter const & emit) override
+    {
+        if (_busy.exchange(true))
+            failed = true;
+
+        if (pts != _next_pts || frames != FRAMES)
+            failed = true;
+
+        // Sample value is the fragment index
+        if (static_cast<std::uint64_t>(samples[0]) != pts / FRAMES)
+            failed = true;
+
+        _next_pts = pts + frames;
+
+        // Some work to let the queues fill up
+        volatile float acc = 0;
+
+        for (std::size_t i = 0; i < frames; i++)
+            acc = acc + samples[i] * samples[i];
+
+        std::uint8_t packet[8];
+
+        for (int b = 0; b < 8; b++)
+            packet[b] = static_cast<std::uint8_t>(pts >> (8 * b));
+
+        emit(packet, sizeof(packet), pts);
+        _busy = false;
+    }
+
+    void flush (packet_emitter const &) override
+    {
+        flushes++;
+    }
+};
+
+// `producers` capture threads submit `fragments` fragments to each of
+// their streams.
+static void ordered_lanes (std::size_t threads, std::size_t streams, std::size_t producers
+    , std::size_t fragments)
+{
+    encoder_pipeline_options opts;
+    opts.threads = threads;
+    opts.max_streams = streams;
+    opts.queue_capacity = 16;
+    opts.max_frames = FRAMES;
+
+    std::vector<std::atomic<std::uint64_t>> next_pts(streams);
+    std::atomic<bool> sink_failed {false};
+
+    for (auto & x: next_pts)
+        x = 0;
+
+    std::vector<checking_encoder *> encoders;
+
+    encoder_pipeline pipeline {opts, [&] (encoded_packet const & p) {
+        if (p.pts != next_pts[p.stream].load() || p.size != 8)
+            sink_failed = true;
+
+        next_pts[p.stream] = p.pts + FRAMES;
+    }};
+
+    for (std::size_t i = 0; i < streams; i++) {
+        auto enc = new checking_encoder;
+        encoders.push_back(enc);
+        CHECK(pipeline.add_stream(std::unique_ptr<encoder>{enc}, 1) == static_cast<int>(i));
+    }
+
+    // Stream limit
+    CHECK(pipeline.add_stream(std::unique_ptr<encoder>{new checking_encoder}, 1) < 0);
+
+    std::vector<std::thread> capture;
+
+    for (std::size_t t = 0; t < producers; t++) {
+        capture.emplace_back([&, t] {
+            std::vector<float> samples(FRAMES);
+
+            for (std::size_t f = 0; f < fragments; f++) {
+                for (std::size_t s = t; s < streams; s += producers) {
+                    std::fill(samples.begin(), samples.end(), static_cast<float>(f));
+
+                    // Queue full: wait like a capture thread would drop and
+                    // resend (keeps the content ordered for the check)
+                    while (!pipeline.submit(static_cast<int>(s), samples.data(), FRAMES))
+                        std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (auto & t: capture)
+        t.join();
+
+    pipeline.stop();
+
+    std::uint64_t rejected = 0;
+    std::size_t high_watermark = 0;
+
+    for (std::size_t i = 0; i < streams; i++) {
+        auto st = pipeline.stats(static_cast<int>(i));
+
+        CHECK(st.submitted == fragments);
+        CHECK(st.encoded == fragments);
+        CHECK(st.queued == 0);
+        CHECK(!encoders[i]->failed);
+        CHECK(encoders[i]->flushes == 1);
+        CHECK(next_pts[i] == fragments * FRAMES);
+
+        rejected += st.rejected;
+        high_watermark = std::max(high_watermark, st.high_watermark);
+    }
+
+    std::cout << "threads " << threads << ", streams " << streams << ", producers " << producers
+        << ": rejected (retried) " << rejected << ", max queue depth " << high_watermark << "\n";
+
+    CHECK(!sink_failed);
+    CHECK(!pipeline.submit(0, nullptr, 0));
+}
+
+// Workers are idle most of the time: every submit wakes one of them.
+static void start_stop ()
+{
+    for (int i = 0; i < 200; i++) {
+        encoder_pipeline_options opts;
+        opts.threads = 1 + i % 4;
+        opts.max_streams = 4;
+        opts.max_frames = FRAMES;
+
+        std::atomic<int> packets {0};
+        encoder_pipeline pipeline {opts, [& packets] (encoded_packet const &) { packets++; }};
+        std::vector<float> samples(FRAMES, 0.f);
+
+        for (int s = 0; s < 4; s++)
+            pipeline.add_stream(std::unique_ptr<encoder>{new checking_encoder}, 1);
+
+        for (int f = 0; f < 3; f++) {
+            std::fill(samples.begin(), samples.end(), static_cast<float>(f));
+
+            for (int s = 0; s < 4; s++)
+                pipeline.submit(s, samples.data(), FRAMES);
+        }
+
+        pipeline.stop();
+        CHECK(packets == 12);
+    }
+}
+
+int main ()
+{
+    ordered_lanes(1, 8, 1, 500);
+    ordered_lanes(4, 64, 4, 200);
+    ordered_lanes(3, 7, 2, 300);
+    start_stop();
+
+    return TEST_RESULT();
+}
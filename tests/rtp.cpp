@@ -0,0 +1,332 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Added payload clock rate and truncated datagrams tests.
+////////////////////////////////////////////////////////////////////////////////
+#include "check.hpp"
+#include "pfs/multimedia/rtp.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+
+#ifndef _WIN32
+#   include <arpa/inet.h>
+#   include <netinet/in.h>
+#   include <sys/socket.h>
+#endif
+
+using namespace multimedia::rtp;
+
+static std::uint32_t const PACKET_DURATION = 960; // 20 ms at 48 kHz
+static std::int64_t const PACKET_USEC = 20000;
+
+struct injector_options
+{
+    double loss {0};
+    double reorder {0};       // Probability of extra delay by 1..3 packets
+    double duplicate {0};
+    std::int64_t jitter_usec {0};
+};
+
+struct arrival
+{
+    std::int64_t time_usec;
+    packet_buffer packet;
+};
+
+// Packetizes `count` packets (payload is the packet index) and passes them
+// through the network simulator injecting loss, reordering, duplication
+// and delay jitter. Returns packets in arrival order.
+static std::vector<arrival> transmit (std::size_t count
+    , std::uint16_t initial_sequence
+    , std::uint32_t initial_timestamp
+    , injector_options const & opts
+    , unsigned seed)
+{
+    std::mt19937 rng {seed};
+    std::uniform_real_distribution<double> chance {0, 1};
+    std::uniform_int_distribution<std::int64_t> jitter {-opts.jitter_usec, opts.jitter_usec};
+    std::uniform_int_distribution<std::int64_t> reorder_packets {1, 3};
+
+    packetizer p {PAYLOAD_OPUS, 0x1234, initial_sequence, initial_timestamp};
+    std::vector<arrival> result;
+
+    for (std::size_t i = 0; i < count; i++) {
+        std::uint8_t payload[4];
+
+        for (int b = 0; b < 4; b++)
+            payload[b] = static_cast<std::uint8_t>(i >> (8 * b));
+
+        arrival a;
+        p.pack(payload, sizeof(payload), PACKET_DURATION, a.packet);
+
+        // Constant network delay of 30 ms plus jitter
+        a.time_usec = static_cast<std::int64_t>(i) * PACKET_USEC + 30000 + jitter(rng);
+
+        if (chance(rng) < opts.loss)
+            continue;
+
+        if (chance(rng) < opts.reorder)
+            a.time_usec += reorder_packets(rng) * PACKET_USEC;
+
+        result.push_back(a);
+
+        if (chance(rng) < opts.duplicate) {
+            result.back().time_usec += 1;
+            result.push_back(a);
+        }
+    }
+
+    std::stable_sort(result.begin(), result.end(), [] (arrival const & a, arrival const & b) {
+        return a.time_usec < b.time_usec;
+    });
+
+    return result;
+}
+
+struct playout_result
+{
+    jitter_buffer_stats stats;
+    std::size_t buffered {0};
+    std::size_t played {0};
+    bool ordered {true};
+};
+
+// Feeds arrivals into the jitter buffer and pops one packet every 20 ms
+// (playback clock) starting with the first arrival.
+static playout_result playout (std::vector<arrival> const & arrivals, jitter_buffer_options const & opts)
+{
+    jitter_buffer jb {opts};
+    playout_result result;
+    packet_buffer out;
+    std::int64_t last_index = -1;
+
+    std::size_t next = 0;
+    std::int64_t end = arrivals.back().time_usec + 10 * PACKET_USEC;
+
+    for (std::int64_t t = arrivals.front().time_usec; t < end; t += PACKET_USEC) {
+        for (; next < arrivals.size() && arrivals[next].time_usec <= t; next++)
+            CHECK(jb.push(arrivals[next].packet, arrivals[next].time_usec));
+
+        if (jb.pop(out) == playout_status::ok) {
+            CHECK(out.size == 4);
+
+            std::int64_t index = out.data[0] | (out.data[1] << 8) | (out.data[2] << 16)
+                | (static_cast<std::int64_t>(out.data[3]) << 24);
+
+            if (index <= last_index)
+                result.ordered = false;
+
+            last_index = index;
+            result.played++;
+        }
+    }
+
+    result.stats = jb.stats();
+    result.buffered = jb.buffered();
+    return result;
+}
+
+// Constant delay: no jitter must be estimated when timestamps and sequence
+// numbers wrap around.
+static void wraparound ()
+{
+    jitter_buffer_options opts;
+    opts.packet_duration = PACKET_DURATION;
+
+    auto arrivals = transmit(500, 65500, 0xFFFFFFFFu - 100 * PACKET_DURATION, injector_options{}, 1);
+    auto r = playout(arrivals, opts);
+
+    std::cout << "wraparound: jitter " << r.stats.jitter << ", played " << r.played
+        << ", lost " << r.stats.lost << "\n";
+
+    CHECK(r.stats.jitter < 1.0);
+    CHECK(r.stats.lost == 0);
+    CHECK(r.stats.dropped == 0);
+    CHECK(r.played + r.buffered == 500);
+    CHECK(r.ordered);
+}
+
+// Loss, reordering, duplication and jitter: every received packet is
+// accounted exactly once and estimations do not depend on the initial
+// timestamp (wraparound).
+static void impaired_network (injector_options const & inj, unsigned seed)
+{
+    jitter_buffer_options opts;
+    opts.packet_duration = PACKET_DURATION;
+
+    std::size_t const count = 20000;
+    auto arrivals = transmit(count, 0, 0, inj, seed);
+    auto wrapped = transmit(count, 65000, 0xFFFFFFFFu - 5000 * PACKET_DURATION, inj, seed);
+
+    auto r = playout(arrivals, opts);
+    auto w = playout(wrapped, opts);
+
+    std::cout << "loss " << inj.loss << ", reorder " << inj.reorder
+        << ", duplicate " << inj.duplicate << ", jitter " << inj.jitter_usec << " us"
+        << ": received " << r.stats.received
+        << ", played " << r.stats.played
+        << ", lost " << r.stats.lost
+        << ", late " << r.stats.late
+        << ", duplicated " << r.stats.duplicated
+        << ", dropped " << r.stats.dropped
+        << ", jitter " << r.stats.jitter << "\n";
+
+    CHECK(r.ordered);
+    CHECK(r.played == r.stats.played);
+    CHECK(r.stats.received == arrivals.size());
+    CHECK(r.stats.received == r.stats.played + r.stats.late + r.stats.duplicated
+        + r.stats.dropped + r.buffered);
+
+    // Sequence numbers and timestamps wrap around several times
+    CHECK(w.stats.played == r.stats.played);
+    CHECK(w.stats.lost == r.stats.lost);
+    CHECK(w.stats.late == r.stats.late);
+    CHECK(w.stats.dropped == r.stats.dropped);
+    CHECK(std::fabs(w.stats.jitter - r.stats.jitter) < 1.0);
+
+    // Uniform jitter of +-J gives mean |D| of 2J/3 (plus reordering)
+    double expected_jitter = 2.0 * static_cast<double>(inj.jitter_usec) / 3 * 48000 / 1e6;
+    CHECK(r.stats.jitter < expected_jitter * 2 + 100);
+
+    // Most of the packets are played, concealment covers the rest
+    CHECK(static_cast<double>(r.stats.played) > count * (1 - inj.loss) * 0.95);
+}
+
+// Burst arrival with gaps: latency reduction drops only buffered packets.
+static void burst_with_gaps ()
+{
+    jitter_buffer_options opts;
+    opts.packet_duration = PACKET_DURATION;
+
+    jitter_buffer jb {opts};
+    packetizer p {PAYLOAD_OPUS, 1};
+    packet_buffer packet;
+    std::uint8_t payload[4] {};
+    std::size_t pushed = 0;
+
+    // Every third packet is lost, all arrive at once
+    for (int i = 0; i < 60; i++) {
+        p.pack(payload, sizeof(payload), PACKET_DURATION, packet);
+
+        if (i % 3 != 2) {
+            jb.push(packet, 0);
+            pushed++;
+        }
+    }
+
+    auto before = jb.buffered();
+    jb.pop(packet);
+
+    std::cout << "burst: buffered " << before << " -> " << jb.buffered()
+        << ", dropped " << jb.stats().dropped << "\n";
+
+    CHECK(before == pushed);
+    CHECK(jb.stats().dropped + jb.stats().played == before - jb.buffered());
+}
+
+static void clock_rates ()
+{
+    CHECK(payload_clock_rate(PAYLOAD_L16_STEREO) == 44100);
+    CHECK(payload_clock_rate(PAYLOAD_L16_MONO) == 44100);
+    CHECK(payload_clock_rate(PAYLOAD_OPUS) == 48000);
+    CHECK(payload_clock_rate(96) == 0);
+}
+
+#ifndef _WIN32
+// Datagrams larger than the packet buffer are dropped, not parsed as whole
+// packets.
+static void truncated_datagrams ()
+{
+    multimedia::error_code ec;
+    udp_socket rx;
+    udp_socket tx;
+
+    CHECK(rx.valid() && tx.valid());
+
+    if (!CHECK(rx.bind("127.0.0.1", 0, ec)))
+        return;
+
+    sockaddr_in addr {};
+    socklen_t len = sizeof(addr);
+    ::getsockname(rx.native_handle(), reinterpret_cast<sockaddr *>(& addr), & len);
+
+    if (!CHECK(tx.connect("127.0.0.1", ntohs(addr.sin_port), ec)))
+        return;
+
+    std::vector<std::uint8_t> large(PACKET_SIZE_MAX + 100, 0x80);
+    std::uint8_t payload[4] {1, 2, 3, 4};
+    packetizer p {PAYLOAD_OPUS, 1};
+    packet_buffer packets[3];
+
+    p.pack(payload, sizeof(payload), PACKET_DURATION, packets[0]);
+    p.pack(payload, sizeof(payload), PACKET_DURATION, packets[1]);
+
+    CHECK(tx.send(& packets[0], 1, ec) == 1);
+    CHECK(::send(tx.native_handle(), large.data(), large.size(), 0) == static_cast<ssize_t>(large.size()));
+    CHECK(tx.send(& packets[1], 1, ec) == 1);
+
+    packet_buffer received[4];
+    int count = 0;
+
+    for (int attempt = 0; attempt < 10 && count < 2; attempt++) {
+        auto n = rx.receive(received + count, 4 - static_cast<std::size_t>(count), 100, ec);
+
+        if (!CHECK(n >= 0))
+            break;
+
+        count += n;
+    }
+
+    CHECK(count == 2);
+    CHECK(rx.truncated() == 1);
+
+    header h;
+    std::uint8_t const * data = nullptr;
+    std::size_t size = 0;
+
+    for (int i = 0; i < count; i++) {
+        CHECK(parse(received[i].data, received[i].size, h, & data, & size));
+        CHECK(h.sequence == static_cast<std::uint16_t>(i));
+        CHECK(size == sizeof(payload));
+    }
+
+    // Operations on the closed socket fail without touching the descriptor
+    rx.close();
+    CHECK(!rx.valid());
+    CHECK(rx.receive(received, 1, 0, ec) < 0);
+    CHECK(ec == std::make_error_code(std::errc::bad_file_descriptor));
+}
+#endif
+
+int main ()
+{
+    clock_rates();
+    wraparound();
+
+    injector_options inj;
+    inj.loss = 0.05;
+    inj.reorder = 0.05;
+    inj.duplicate = 0.01;
+    inj.jitter_usec = 5000;
+    impaired_network(inj, 1);
+
+    inj.loss = 0.2;
+    inj.reorder = 0.1;
+    inj.jitter_usec = 15000;
+    impaired_network(inj, 2);
+
+    burst_with_gaps();
+
+#ifndef _WIN32
+    truncated_datagrams();
+#endif
+
+    return TEST_RESULT();
+}
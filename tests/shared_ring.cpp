@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "check.hpp"
+#include "pfs/multimedia/shared_ring.hpp"
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+#include <cstdint>
+
+using namespace multimedia;
+using namespace multimedia::audio;
+
+static std::size_t const CAPACITY = 1024;
+
+// Frames are 32-bit frame indices.
+static void write_frames (shared_ring_writer & w, std::uint32_t first, std::size_t count)
+{
+    std::vector<std::uint32_t> frames(count);
+
+    for (std::size_t i = 0; i < count; i++)
+        frames[i] = first + static_cast<std::uint32_t>(i);
+
+    w.write(frames.data(), count);
+}
+
+static void read_write ()
+{
+    error_code ec;
+    shared_ring_writer w;
+
+    CHECK(w.create("test", 1, 48000, sizeof(std::uint32_t), 1000, ec));
+    CHECK(w.info().capacity_frames == CAPACITY);
+
+    shared_ring_reader r;
+    CHECK(r.open(w.native_handle(), ec));
+    CHECK(w.readers() == 1);
+
+    write_frames(w, 0, 600);
+
+    std::vector<std::uint32_t> frames(CAPACITY);
+    auto n = r.read(frames.data(), frames.size());
+
+    CHECK(n == 600);
+    CHECK(frames[0] == 0 && frames[599] == 599);
+    CHECK(w.lagging_readers(0) == 0);
+
+    // Writer laps the reader: only the last `CAPACITY` frames are readable
+    write_frames(w, 600, 3000);
+    CHECK(w.lagging_readers(CAPACITY) == 1);
+
+    n = r.read(frames.data(), frames.size());
+
+    CHECK(n == CAPACITY);
+    CHECK(frames[0] == 3600 - CAPACITY);
+    CHECK(r.lost_frames() == 3000 - CAPACITY);
+    CHECK(r.overruns() == 1);
+
+    r.close();
+    CHECK(w.readers() == 0);
+}
+
+// Reader process attaches and terminates without detaching.
+static pid_t crashing_reader (int fd, bool detach)
+{
+    auto pid = ::fork();
+
+    if (pid == 0) {
+        error_code ec;
+        shared_ring_reader r;
+
+        if (!r.open(fd, ec))
+            ::_exit(1);
+
+        if (detach)
+            r.close();
+
+        // No destructors: slot stays occupied
+        ::_exit(0);
+    }
+
+    return pid;
+}
+
+static void dead_readers ()
+{
+    error_code ec;
+    shared_ring_writer w;
+
+    CHECK(w.create("test", 1, 48000, sizeof(std::uint32_t), CAPACITY, ec));
+
+    // This process reader stays alive
+    shared_ring_reader alive;
+    CHECK(alive.open(w.native_handle(), ec));
+
+    for (int i = 0; i < 3; i++) {
+        int status = 0;
+        auto pid = crashing_reader(w.native_handle(), i == 0);
+        ::waitpid(pid, & status, 0);
+        CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+
+    // One reader detached properly
+    CHECK(w.readers() == 3);
+    CHECK(w.reclaim_readers() == 2);
+    CHECK(w.readers() == 1);
+    CHECK(w.reclaim_readers() == 0);
+
+    // Fill all slots with dead readers: attach reclaims them
+    for (std::size_t i = 1; i < SHARED_RING_READERS_MAX; i++) {
+        int status = 0;
+        auto pid = crashing_reader(w.native_handle(), false);
+        ::waitpid(pid, & status, 0);
+        CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+
+    CHECK(w.readers() == SHARED_RING_READERS_MAX);
+
+    shared_ring_reader r;
+    CHECK(r.open(w.native_handle(), ec));
+    CHECK(w.readers() == SHARED_RING_READERS_MAX);
+
+    write_frames(w, 0, 10);
+    std::vector<std::uint32_t> frames(10);
+    CHECK(r.read(frames.data(), frames.size()) == 10);
+    CHECK(alive.read(frames.data(), frames.size()) == 10);
+
+    // Live reader slots are never reclaimed
+    CHECK(w.reclaim_readers() == SHARED_RING_READERS_MAX - 2);
+    CHECK(w.readers() == 2);
+}
+
+int main ()
+{
+    read_write();
+    dead_readers();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "check.hpp"
+#include "pfs/multimedia/spectrum_analyzer.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <cmath>
+
+using namespace multimedia::audio;
+
+static double const PI = 3.14159265358979323846;
+
+// Compares magnitudes with the direct DFT for sizes with even and odd
+// log2(n / 2) (with and without leading radix-2 pass).
+static void compare_with_dft (std::size_t n)
+{
+    spectrum_options opts;
+    opts.fft_size = n;
+    opts.window = window_type::rectangular;
+
+    spectrum_analyzer sa {opts};
+
+    std::mt19937 rng {static_cast<unsigned>(n)};
+    std::uniform_real_distribution<float> dist {-1.f, 1.f};
+    std::vector<float> frame(n);
+
+    for (auto & x: frame)
+        x = dist(rng);
+
+    float const * mag = sa.analyze(frame.data());
+    double max_error = 0;
+
+    for (std::size_t k = 0; k <= n / 2; k++) {
+        double xr = 0, xi = 0;
+
+        for (std::size_t i = 0; i < n; i++) {
+            double a = -2 * PI * static_cast<double>((k * i) % n) / static_cast<double>(n);
+            xr += frame[i] * std::cos(a);
+            xi += frame[i] * std::sin(a);
+        }
+
+        double expected = std::sqrt(xr * xr + xi * xi) * 2 / static_cast<double>(n);
+
+        if (k == 0 || k == n / 2)
+            expected *= 0.5;
+
+        max_error = std::max(max_error, std::fabs(expected - mag[k]));
+    }
+
+    std::cout << "n = " << n << ": max error " << max_error << "\n";
+
+    CHECK(sa.bins_count() == n / 2 + 1);
+    CHECK(max_error < 1e-5);
+}
+
+// Full scale sine at the bin center has amplitude 1.0 (0 dBFS).
+static void sine_amplitude (window_type window)
+{
+    std::size_t const n = 1024;
+    std::size_t const bin = 64;
+
+    spectrum_options opts;
+    opts.fft_size = n;
+    opts.window = window;
+    opts.decibels = true;
+
+    spectrum_analyzer sa {opts};
+    std::vector<float> frame(n);
+
+    for (std::size_t i = 0; i < n; i++)
+        frame[i] = static_cast<float>(std::sin(2 * PI * bin * i / n));
+
+    float const * mag = sa.analyze(frame.data());
+    auto peak = std::max_element(mag, mag + sa.bins_count()) - mag;
+
+    CHECK(static_cast<std::size_t>(peak) == bin);
+    CHECK(std::fabs(mag[bin]) < 0.01f);
+}
+
+// Overlapped frames: every `hop_size` samples after the first `fft_size`.
+static void frames_count ()
+{
+    spectrum_options opts;
+    opts.fft_size = 512;
+    opts.hop_size = 128;
+
+    std::size_t frames = 0;
+    spectrum_analyzer sa {opts, [& frames] (float const *, std::size_t count) {
+        CHECK(count == 257);
+        frames++;
+    }};
+
+    std::vector<float> input(4096, 0.5f);
+
+    // Two interleaved channels, analyze the first one in chunks
+    std::vector<float> stereo(2 * input.size());
+
+    for (std::size_t i = 0; i < input.size(); i++)
+        stereo[2 * i] = input[i];
+
+    for (std::size_t i = 0; i < input.size(); i += 1000)
+        sa.process(stereo.data() + 2 * i, std::min<std::size_t>(1000, input.size() - i), 2);
+
+    CHECK(frames == 1 + (4096 - 512) / 128);
+}
+
+int main ()
+{
+    for (std::size_t n = 4; n <= 4096; n *= 2)
+        compare_with_dft(n);
+
+    sine_amplitude(window_type::hann);
+    sine_amplitude(window_type::blackman_harris);
+    frames_count();
+
+    return TEST_RESULT();
+}
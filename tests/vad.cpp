@@ -0,0 +1,194 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "check.hpp"
+#include "pfs/multimedia/vad.hpp"
+#include <random>
+#include <vector>
+#include <cmath>
+
+using namespace multimedia::audio;
+
+static std::size_t const BLOCK_FRAMES = 480;
+
+static float from_db (float db)
+{
+    return std::pow(10.f, db / 20.f);
+}
+
+// Background noise with speech-like bursts (amplitude modulated harmonic
+// tone) of 0.5 s every 2 s. Returns interleaved samples, same signal in
+// every channel.
+static std::vector<float> make_bursts (int channels, int seconds, std::vector<bool> & voiced_blocks)
+{
+    std::mt19937 rng {1};
+    std::normal_distribution<float> noise {0.f, from_db(-60.f)};
+    std::size_t frames = static_cast<std::size_t>(seconds) * 48000;
+    std::vector<float> result(frames * static_cast<std::size_t>(channels));
+
+    voiced_blocks.assign(frames / BLOCK_FRAMES, false);
+
+    for (std::size_t i = 0; i < frames; i++) {
+        auto t = static_cast<double>(i) / 48000;
+        bool burst = std::fmod(t, 2.0) >= 1.0 && std::fmod(t, 2.0) < 1.5;
+        float x = noise(rng);
+
+        if (burst) {
+            auto envelope = 0.1 * (1 + 0.5 * std::sin(2 * 3.14159265 * 4 * t));
+
+            for (int h = 1; h <= 5; h++)
+                x += static_cast<float>(envelope / h * std::sin(2 * 3.14159265 * 150 * h * t));
+
+            voiced_blocks[i / BLOCK_FRAMES] = true;
+        }
+
+        for (int ch = 0; ch < channels; ch++)
+            result[i * static_cast<std::size_t>(channels) + static_cast<std::size_t>(ch)] = x;
+    }
+
+    return result;
+}
+
+static void bursts (int channels, float flux_threshold)
+{
+    std::vector<bool> expected;
+    auto samples = make_bursts(channels, 10, expected);
+
+    vad_options opts;
+    opts.channels = channels;
+    opts.block_frames = BLOCK_FRAMES;
+    opts.flux_threshold = flux_threshold;
+
+    std::size_t delivered = 0;
+    std::size_t first_voiced = 0;
+    bool onset_found = false;
+
+    voice_activity_detector vad {opts, [&] (float const *, std::size_t frames, bool voiced) {
+        CHECK(voiced);
+        CHECK(frames == BLOCK_FRAMES);
+        delivered++;
+    }};
+
+    // Feed in chunks not aligned to blocks
+    std::size_t const chunk = 333;
+    std::size_t frames = samples.size() / static_cast<std::size_t>(channels);
+    std::size_t missed = 0;
+
+    for (std::size_t i = 0; i < frames; i += chunk) {
+        auto n = std::min(chunk, frames - i);
+        auto blocks_before = vad.stats().blocks_total;
+
+        vad.process(samples.data() + i * static_cast<std::size_t>(channels), n);
+
+        // Blocks completed by this chunk
+        for (auto b = blocks_before; b < vad.stats().blocks_total; b++) {
+            if (expected[b] && !vad.voiced())
+                missed++;
+
+            if (!onset_found && vad.voiced()) {
+                onset_found = true;
+                first_voiced = b;
+            }
+        }
+    }
+
+    auto const & stats = vad.stats();
+
+    std::cout << "channels " << channels << ", flux threshold " << flux_threshold
+        << ": blocks " << stats.blocks_total
+        << ", voiced " << stats.blocks_voiced
+        << ", dropped " << stats.blocks_dropped
+        << ", missed " << missed
+        << ", first onset " << first_voiced << "\n";
+
+    // Every block is either delivered or dropped, pre-roll is not counted twice
+    CHECK(stats.blocks_total == frames / BLOCK_FRAMES);
+    CHECK(stats.blocks_total == stats.blocks_voiced + stats.blocks_dropped);
+    CHECK(delivered == stats.blocks_voiced);
+
+    // First burst starts at 1.0 s (block 100), detected in the first
+    // block and delivered with the pre-roll
+    CHECK(onset_found && first_voiced == 100);
+    CHECK(missed == 0);
+
+    // 5 bursts of 50 blocks with pre-roll and hangover, silence is dropped
+    auto max_voiced = 5 * static_cast<std::uint64_t>(50 + opts.preroll_blocks + opts.hangover_blocks + 1);
+    CHECK(stats.blocks_voiced >= 5 * 50);
+    CHECK(stats.blocks_voiced <= max_voiced);
+}
+
+// Noise rising by 6 dB/s outruns the noise floor tracking and exceeds the
+// energy threshold, but has no spectral onset.
+static void rising_noise (float flux_threshold, bool expect_voiced)
+{
+    vad_options opts;
+    opts.block_frames = BLOCK_FRAMES;
+    opts.flux_threshold = flux_threshold;
+
+    voice_activity_detector vad {opts, nullptr};
+
+    std::mt19937 rng {2};
+    std::normal_distribution<float> noise {0.f, 1.f};
+    std::vector<float> block(BLOCK_FRAMES);
+    std::uint64_t voiced_blocks = 0;
+
+    // 8 s: from -70 dBFS to -22 dBFS
+    for (int b = 0; b < 800; b++) {
+        float gain = from_db(-70.f + 6.f * static_cast<float>(b) / 100);
+
+        for (auto & x: block)
+            x = noise(rng) * gain;
+
+        vad.process(block.data(), block.size());
+
+        if (vad.voiced())
+            voiced_blocks++;
+    }
+
+    std::cout << "rising noise, flux threshold " << flux_threshold
+        << ": voiced blocks " << voiced_blocks << "\n";
+
+    CHECK((voiced_blocks > 0) == expect_voiced);
+}
+
+static void keep_silence ()
+{
+    vad_options opts;
+    opts.block_frames = BLOCK_FRAMES;
+    opts.drop_silence = false;
+
+    std::vector<bool> expected;
+    auto samples = make_bursts(1, 4, expected);
+    std::size_t delivered = 0;
+    std::size_t voiced = 0;
+
+    voice_activity_detector vad {opts, [&] (float const *, std::size_t, bool v) {
+        delivered++;
+
+        if (v)
+            voiced++;
+    }};
+
+    vad.process(samples.data(), samples.size());
+
+    CHECK(delivered == vad.stats().blocks_total);
+    CHECK(voiced == vad.stats().blocks_voiced);
+    CHECK(vad.stats().blocks_dropped == 0);
+}
+
+int main ()
+{
+    bursts(1, 0.f);
+    bursts(1, 0.5f);
+    bursts(2, 0.5f);
+    rising_noise(0.f, true);
+    rising_noise(0.5f, false);
+    keep_silence();
+
+    return TEST_RESULT();
+}
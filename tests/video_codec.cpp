@@ -0,0 +1,167 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "check.hpp"
+#include "pfs/multimedia/decode_pipeline.hpp"
+#include "pfs/multimedia/video_encoder.hpp"
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+
+extern "C" {
+#include <libavutil/frame.h>
+}
+
+using namespace multimedia;
+
+static int const WIDTH = 320;
+static int const HEIGHT = 240;
+static int const FRAME_RATE = 30;
+static int const FRAMES = 45;
+
+// Flat gray frame, level differs from frame to frame so the order of
+// decoded frames can be checked.
+static std::uint8_t level (int n)
+{
+    return static_cast<std::uint8_t>(40 + (n * 37) % 180);
+}
+
+static double mean_luma (std::uint8_t const * data, std::size_t stride, int width, int height)
+{
+    double sum = 0;
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++)
+            sum += data[static_cast<std::size_t>(y) * stride + static_cast<std::size_t>(x)];
+    }
+
+    return sum / (width * height);
+}
+
+// RGBA frames are converted and encoded into H.264 (with B-frames, so the
+// decoder reorders them) in MP4, then decoded back: number of frames,
+// their size, presentation times and order are preserved.
+static void round_trip ()
+{
+    std::string path = "video_codec_test.mp4";
+
+    video::encoder_options opts;
+    opts.width = WIDTH;
+    opts.height = HEIGHT;
+    opts.frame_rate = FRAME_RATE;
+    opts.preset = "ultrafast";
+    opts.max_b_frames = 2;
+    opts.gop_size = 15;
+
+    video::frame_pool pool {video::pixel_format::rgba, WIDTH, HEIGHT};
+    std::vector<double> expected_luma;
+
+    {
+        video::encoder enc;
+        error_code ec;
+
+        if (!CHECK(enc.open(path, opts, ec))) {
+            std::cerr << "encoder open failure: " << ec.message() << "\n";
+            return;
+        }
+
+        for (int n = 0; n < FRAMES; n++) {
+            auto f = pool.acquire();
+
+            for (int y = 0; y < HEIGHT; y++) {
+                for (int x = 0; x < WIDTH; x++) {
+                    auto p = f.data(0) + y * f.stride(0) + 4 * x;
+                    p[0] = p[1] = p[2] = level(n);
+                    p[3] = 255;
+                }
+            }
+
+            auto yuv = video::frame::allocate(video::pixel_format::i420, WIDTH, HEIGHT);
+            CHECK(video::convert(f, yuv, opts.cs, 1));
+            expected_luma.push_back(mean_luma(yuv.data(0), yuv.stride(0), WIDTH, HEIGHT));
+
+            CHECK(enc.submit(f));
+        }
+
+        CHECK(enc.finish(ec));
+        CHECK(enc.packets_count() == static_cast<std::size_t>(FRAMES));
+    }
+
+    video::decode_pipeline decoder;
+    video::decode_options dopts;
+    error_code ec;
+
+    if (!CHECK(decoder.open(path, dopts, ec))) {
+        std::cerr << "decoder open failure: " << ec.message() << "\n";
+        std::remove(path.c_str());
+        return;
+    }
+
+    auto info = decoder.info(video::media_type::video);
+
+    CHECK(info.present);
+    CHECK(info.width == WIDTH);
+    CHECK(info.height == HEIGHT);
+    CHECK(!decoder.info(video::media_type::audio).present);
+
+    int count = 0;
+    video::decoded_frame df;
+
+    while (decoder.read(video::media_type::video, df)) {
+        auto av = df.native();
+
+        CHECK(av->width == WIDTH);
+        CHECK(av->height == HEIGHT);
+
+        if (count < FRAMES) {
+            // Presentation order with pts of the submitted frames
+            CHECK(std::fabs(df.time() - static_cast<double>(count) / FRAME_RATE) < 1e-3);
+
+            auto luma = mean_luma(av->data[0], static_cast<std::size_t>(av->linesize[0]), WIDTH, HEIGHT);
+            CHECK(std::fabs(luma - expected_luma[static_cast<std::size_t>(count)]) < 3);
+        }
+
+        count++;
+    }
+
+    std::cout << "round trip: " << count << " of " << FRAMES << " frames decoded\n";
+
+    CHECK(count == FRAMES);
+
+    decoder.close();
+    std::remove(path.c_str());
+}
+
+// Frame size mismatch is rejected by `submit()`, finish succeeds.
+static void invalid_frames ()
+{
+    video::encoder_options opts;
+    opts.width = WIDTH;
+    opts.height = HEIGHT;
+    opts.preset = "ultrafast";
+
+    std::size_t packets = 0;
+    video::encoder enc;
+    error_code ec;
+
+    CHECK(enc.open([& packets] (video::packet const &) { packets++; }, opts, ec));
+    CHECK(!enc.submit(video::frame::allocate(video::pixel_format::i420, WIDTH / 2, HEIGHT)));
+    CHECK(!enc.submit(video::frame{}));
+    CHECK(enc.submit(video::frame::allocate(video::pixel_format::nv12, WIDTH, HEIGHT)));
+    CHECK(enc.finish(ec));
+    CHECK(packets == 1);
+}
+
+int main ()
+{
+    round_trip();
+    invalid_frames();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,226 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+////////////////////////////////////////////////////////////////////////////////
+#include "check.hpp"
+#include "pfs/multimedia/video.hpp"
+#include <algorithm>
+#include <initializer_list>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <cstdlib>
+
+using namespace multimedia::video;
+
+static void pool_recycling ()
+{
+    frame_pool pool {pixel_format::i420, 64, 48, 2};
+    std::uint8_t const * data = nullptr;
+
+    {
+        auto f = pool.acquire();
+        CHECK(!f.empty());
+        CHECK(pool.free_count() == 0);
+        data = f.data(0);
+
+        // Copies share the buffer
+        auto copy = f;
+        CHECK(copy.data(0) == data);
+
+        auto moved = std::move(copy);
+        CHECK(copy.empty());
+        CHECK(moved.data(0) == data);
+
+        f = frame{};
+        CHECK(pool.free_count() == 0);
+    }
+
+    CHECK(pool.free_count() == 1);
+
+    // Buffer is reused
+    auto f1 = pool.acquire();
+    CHECK(f1.data(0) == data);
+    CHECK(pool.free_count() == 0);
+
+    // Pool keeps at most `max_free` idle buffers
+    {
+        std::vector<frame> frames;
+
+        for (int i = 0; i < 4; i++)
+            frames.push_back(pool.acquire());
+    }
+
+    CHECK(pool.free_count() == 2);
+
+    // Self assignment
+    auto const & self = f1;
+    f1 = self;
+    CHECK(f1.data(0) == data);
+}
+
+static void frames_outlive_pool ()
+{
+    std::vector<frame> frames;
+
+    {
+        frame_pool pool {pixel_format::rgba, 32, 32};
+
+        for (int i = 0; i < 3; i++)
+            frames.push_back(pool.acquire());
+
+        frames.push_back(frames.front());
+    }
+
+    for (auto & f: frames)
+        f.data(0)[0] = 1;
+
+    frames.clear();
+}
+
+static void concurrent_release ()
+{
+    frame_pool pool {pixel_format::nv12, 16, 16, 4};
+
+    for (int n = 0; n < 100; n++) {
+        auto f = pool.acquire();
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([f] {
+                auto copy = f;
+                copy = frame{};
+            });
+        }
+
+        f = frame{};
+
+        for (auto & t: threads)
+            t.join();
+    }
+
+    CHECK(pool.free_count() == 1);
+}
+
+static inline int clamp8 (int v)
+{
+    return v < 0 ? 0 : (v > 255 ? 255 : v);
+}
+
+// Pixel-by-pixel BT.601 reference for I420/NV12/YUYV -> RGB24/RGBA.
+static void yuv_to_rgb (pixel_format src_format, pixel_format dst_format, int w, int h)
+{
+    auto src = frame::allocate(src_format, w, h);
+    auto dst = frame::allocate(dst_format, w, h);
+    std::srand(static_cast<unsigned>(w * h));
+
+    for (int i = 0; i < src.planes_count(); i++) {
+        for (int r = 0; r < src.plane_height(i); r++) {
+            for (std::size_t x = 0; x < src.plane_row_bytes(i); x++)
+                src.data(i)[r * src.stride(i) + x] = static_cast<std::uint8_t>(std::rand());
+        }
+    }
+
+    CHECK(convert(src, dst));
+
+    int bpp = dst_format == pixel_format::rgba ? 4 : 3;
+    int failures = 0;
+
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            int yy = 0, u = 0, v = 0;
+
+            switch (src_format) {
+                case pixel_format::i420:
+                    yy = src.data(0)[y * src.stride(0) + x];
+                    u = src.data(1)[y / 2 * src.stride(1) + x / 2];
+                    v = src.data(2)[y / 2 * src.stride(2) + x / 2];
+                    break;
+                case pixel_format::nv12:
+                    yy = src.data(0)[y * src.stride(0) + x];
+                    u = src.data(1)[y / 2 * src.stride(1) + x / 2 * 2];
+                    v = src.data(1)[y / 2 * src.stride(1) + x / 2 * 2 + 1];
+                    break;
+                default:
+                    yy = src.data(0)[y * src.stride(0) + x * 2];
+                    u = src.data(0)[y * src.stride(0) + x / 2 * 4 + 1];
+                    v = src.data(0)[y * src.stride(0) + x / 2 * 4 + 3];
+                    break;
+            }
+
+            int c = 298 * (yy - 16) + 128;
+            u -= 128;
+            v -= 128;
+
+            auto out = dst.data(0) + y * dst.stride(0) + x * bpp;
+
+            if (out[0] != clamp8((c + 409 * v) >> 8)
+                    || out[1] != clamp8((c - 100 * u - 208 * v) >> 8)
+                    || out[2] != clamp8((c + 516 * u) >> 8)
+                    || (bpp == 4 && out[3] != 255)) {
+                failures++;
+            }
+        }
+    }
+
+    CHECK(failures == 0);
+}
+
+// RGB -> YUV -> RGB of a smooth image is close to the original.
+static void round_trip (pixel_format yuv_format, pixel_format rgb_format, int w, int h)
+{
+    auto rgb = frame::allocate(rgb_format, w, h);
+    auto yuv = frame::allocate(yuv_format, w, h);
+    auto back = frame::allocate(rgb_format, w, h);
+    int bpp = rgb_format == pixel_format::rgba ? 4 : 3;
+
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            auto p = rgb.data(0) + y * rgb.stride(0) + x * bpp;
+            p[0] = static_cast<std::uint8_t>(32 + x * 192 / w);
+            p[1] = static_cast<std::uint8_t>(32 + y * 192 / h);
+            p[2] = static_cast<std::uint8_t>(128);
+
+            if (bpp == 4)
+                p[3] = 255;
+        }
+    }
+
+    CHECK(convert(rgb, yuv, color_space::bt709));
+    CHECK(convert(yuv, back, color_space::bt709));
+
+    int max_error = 0;
+
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w * bpp; x++) {
+            int d = std::abs(rgb.data(0)[y * rgb.stride(0) + x] - back.data(0)[y * back.stride(0) + x]);
+            max_error = std::max(max_error, d);
+        }
+    }
+
+    std::cout << "round trip " << w << "x" << h << ": max error " << max_error << "\n";
+    CHECK(max_error <= 6);
+}
+
+int main ()
+{
+    pool_recycling();
+    frames_outlive_pool();
+    concurrent_release();
+
+    for (auto src_format: {pixel_format::i420, pixel_format::nv12, pixel_format::yuyv}) {
+        for (auto dst_format: {pixel_format::rgb24, pixel_format::rgba}) {
+            yuv_to_rgb(src_format, dst_format, 64, 32);
+            yuv_to_rgb(src_format, dst_format, 37, 19);
+            yuv_to_rgb(src_format, dst_format, 1280, 720);
+            round_trip(src_format, dst_format, 53, 27);
+            round_trip(src_format, dst_format, 1280, 720);
+        }
+    }
+
+    return TEST_RESULT();
+}
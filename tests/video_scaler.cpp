@@ -0,0 +1,186 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2026 Vladislav Trifochkin
+//
+// This file is part of `multimedia-lib`.
+//
+// Changelog:
+//      2026.10.19 Initial version.
+//      2026.10.19 Added single pass pyramid test.
+////////////////////////////////////////////////////////////////////////////////
+#include "check.hpp"
+#include "pfs/multimedia/video_scaler.hpp"
+#include <initializer_list>
+#include <cmath>
+#include <cstring>
+
+using namespace multimedia::video;
+
+static double const PI = 3.14159265358979323846;
+
+// Smooth test image: exact downscaled values are known at any resolution.
+static double pattern (double u, double v)
+{
+    return 128.0 + 60.0 * std::sin(2 * PI * 3 * u) * std::cos(2 * PI * 2 * v)
+        + 40.0 * std::cos(2 * PI * 5 * (u + v));
+}
+
+static void fill (frame & f)
+{
+    int channels = f.format() == pixel_format::rgba ? 4 : 1;
+
+    for (int y = 0; y < f.height(); y++) {
+        for (int x = 0; x < f.width(); x++) {
+            auto value = pattern((x + 0.5) / f.width(), (y + 0.5) / f.height());
+
+            for (int c = 0; c < channels; c++)
+                f.data(0)[y * f.stride(0) + x * channels + c] = static_cast<std::uint8_t>(std::lround(value));
+        }
+    }
+
+    for (int p = 1; p < f.planes_count(); p++) {
+        for (int y = 0; y < f.plane_height(p); y++)
+            std::memset(f.data(p) + y * f.stride(p), 128, f.plane_row_bytes(p));
+    }
+}
+
+static bool equal (frame const & a, frame const & b)
+{
+    for (int p = 0; p < a.planes_count(); p++) {
+        for (int y = 0; y < a.plane_height(p); y++) {
+            if (std::memcmp(a.data(p) + y * a.stride(p), b.data(p) + y * b.stride(p), a.plane_row_bytes(p)) != 0)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+// Root mean square error of the luma (first channel) against the pattern.
+static double rms_error (frame const & f)
+{
+    int channels = f.format() == pixel_format::rgba ? 4 : 1;
+    double sum = 0;
+
+    for (int y = 0; y < f.height(); y++) {
+        for (int x = 0; x < f.width(); x++) {
+            auto d = f.data(0)[y * f.stride(0) + x * channels]
+                - pattern((x + 0.5) / f.width(), (y + 0.5) / f.height());
+            sum += d * d;
+        }
+    }
+
+    return std::sqrt(sum / (f.width() * f.height()));
+}
+
+static void pyramid (pixel_format format, scale_filter filter)
+{
+    int const sizes[][2] = {{960, 540}, {480, 270}, {240, 135}, {120, 68}};
+    std::size_t const count = sizeof(sizes) / sizeof(sizes[0]);
+
+    auto src = frame::allocate(format, 1920, 1080);
+    fill(src);
+
+    frame direct[count];
+    frame cascade[count];
+
+    for (std::size_t i = 0; i < count; i++) {
+        direct[i] = frame::allocate(format, sizes[i][0], sizes[i][1]);
+        cascade[i] = frame::allocate(format, sizes[i][0], sizes[i][1]);
+    }
+
+    scaler s {filter, 1};
+
+    CHECK(s.scale(src, direct, count, pyramid_mode::direct));
+    CHECK(s.scale(src, cascade, count, pyramid_mode::cascade));
+
+    for (std::size_t i = 0; i < count; i++) {
+        // Direct pyramid is the same as separate scaling
+        auto single = frame::allocate(format, sizes[i][0], sizes[i][1]);
+        CHECK(s.scale(src, single));
+        CHECK(equal(single, direct[i]));
+
+        auto direct_error = rms_error(direct[i]);
+        auto cascade_error = rms_error(cascade[i]);
+
+        std::cout << "filter " << static_cast<int>(filter) << ", "
+            << sizes[i][0] << "x" << sizes[i][1] << ": RMS error direct " << direct_error
+            << ", cascade " << cascade_error << "\n";
+
+        CHECK(direct_error < 1.5);
+        CHECK(direct_error <= cascade_error + 0.05);
+    }
+
+    // Format mismatch
+    auto other = frame::allocate(format == pixel_format::rgba ? pixel_format::i420 : pixel_format::rgba, 64, 64);
+    CHECK(!s.scale(src, & other, 1));
+}
+
+// Single pass pyramid (with bands processed in parallel) is the same as
+// separate scaling of every level, including upscaled and odd sized ones,
+// and reads the source once (plus rows shared by adjacent bands).
+static void single_pass (pixel_format format, scale_filter filter, std::size_t threads)
+{
+    int const sizes[][2] = {{960, 540}, {1000, 700}, {333, 187}, {2000, 1100}, {120, 68}};
+    std::size_t const count = sizeof(sizes) / sizeof(sizes[0]);
+
+    auto src = frame::allocate(format, 1280, 720);
+    fill(src);
+
+    frame levels[count];
+
+    for (std::size_t i = 0; i < count; i++)
+        levels[i] = frame::allocate(format, sizes[i][0], sizes[i][1]);
+
+    scaler s {filter, threads};
+
+    CHECK(s.scale(src, levels, count));
+
+    for (std::size_t i = 0; i < count; i++) {
+        auto single = frame::allocate(format, sizes[i][0], sizes[i][1]);
+        CHECK(s.scale(src, single));
+        CHECK(equal(single, levels[i]));
+    }
+
+    std::uint64_t source_bytes = 0;
+
+    for (int p = 0; p < src.planes_count(); p++)
+        source_bytes += src.plane_row_bytes(p) * static_cast<std::size_t>(src.plane_height(p));
+
+    auto one_pass = s.traffic(src, levels, count);
+    auto direct = s.traffic(src, levels, count, pyramid_mode::direct);
+
+    std::cout << "single pass, format " << static_cast<int>(format) << ", filter "
+        << static_cast<int>(filter) << ", threads " << threads << ": source read "
+        << static_cast<double>(one_pass.source_bytes) / source_bytes << " times (direct "
+        << static_cast<double>(direct.source_bytes) / source_bytes << ")\n";
+
+    CHECK(one_pass.source_bytes >= source_bytes);
+    CHECK(one_pass.source_bytes < source_bytes * 3 / 2);
+    CHECK(one_pass.level_bytes == 0);
+    CHECK(direct.source_bytes >= source_bytes * count);
+
+    // Invalid level: nothing is written
+    frame mixed[2] = {
+          frame::allocate(format, 64, 64)
+        , frame::allocate(format == pixel_format::rgba ? pixel_format::i420 : pixel_format::rgba, 64, 64)
+    };
+
+    CHECK(!s.scale(src, mixed, 2));
+}
+
+int main ()
+{
+    for (auto filter: {scale_filter::bilinear, scale_filter::bicubic, scale_filter::lanczos}) {
+        pyramid(pixel_format::i420, filter);
+        pyramid(pixel_format::rgba, filter);
+    }
+
+    for (auto filter: {scale_filter::bilinear, scale_filter::lanczos}) {
+        for (auto format: {pixel_format::i420, pixel_format::nv12, pixel_format::rgb24, pixel_format::rgba}) {
+            single_pass(format, filter, 1);
+            single_pass(format, filter, 4);
+        }
+    }
+
+    return TEST_RESULT();
+}